@@ -0,0 +1,247 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#include "archetype.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace NycaTech {
+
+Column::Column(const Layout& layout)
+    : layout(layout),
+      data(nullptr),
+      added(nullptr),
+      changed(nullptr),
+      count(0),
+      capacity(0),
+      latestAdd(0),
+      latestChange(0),
+      owned(true)
+{
+}
+
+Column::~Column()
+{
+  if (!layout.trivial) {
+    for (Uint32 i = 0; i < count; i++) {
+      layout.destroy(At(i));
+    }
+  }
+  if (owned) {
+    ::operator delete(data, std::align_val_t(layout.align));
+    delete[] added;
+    delete[] changed;
+  }
+}
+
+void* Column::At(Uint32 row)
+{
+  return data + static_cast<Uint64>(row) * layout.size;
+}
+
+void* Column::Push(Uint32 tick)
+{
+  if (count >= capacity) {
+    Grow(capacity ? capacity * 2 : 16);
+  }
+  added[count] = tick;
+  changed[count] = tick;
+  latestAdd = std::max(latestAdd, tick);
+  latestChange = std::max(latestChange, tick);
+  return At(count++);
+}
+
+void Column::SwapRemove(Uint32 row)
+{
+  void* removed = At(row);
+  void* last = At(count - 1);
+  if (layout.trivial) {
+    if (removed != last) {
+      memcpy(removed, last, layout.size);
+    }
+  }
+  else {
+    layout.destroy(removed);
+    if (removed != last) {
+      layout.move(removed, last);
+      layout.destroy(last);
+    }
+  }
+  added[row] = added[count - 1];
+  changed[row] = changed[count - 1];
+  count--;
+}
+
+void Column::MarkChanged(Uint32 row, Uint32 tick)
+{
+  changed[row] = tick;
+  Touch(tick);
+}
+
+void Column::Touch(Uint32 tick)
+{
+  latestChange = std::max(latestChange, tick);
+}
+
+// Borrows externally owned rows, e.g. a mapped snapshot, instead of copying them. The column stays on that memory
+// until it needs to grow, at which point it moves everything into storage of its own.
+bool Column::Adopt(Uint8* rows, Uint32* addedTicks, Uint32* changedTicks, Uint32 rowCount)
+{
+  if (count > 0 || !layout.trivial) {
+    return false;
+  }
+  if (owned) {
+    ::operator delete(data, std::align_val_t(layout.align));
+    delete[] added;
+    delete[] changed;
+  }
+
+  data = rows;
+  added = addedTicks;
+  changed = changedTicks;
+  count = rowCount;
+  capacity = rowCount;
+  owned = false;
+  for (Uint32 i = 0; i < rowCount; i++) {
+    latestAdd = std::max(latestAdd, added[i]);
+    latestChange = std::max(latestChange, changed[i]);
+  }
+  return true;
+}
+
+Uint32 Column::Count() const
+{
+  return count;
+}
+
+Uint32* Column::AddedTicks()
+{
+  return added;
+}
+
+Uint32* Column::ChangedTicks()
+{
+  return changed;
+}
+
+Uint32 Column::LatestAdd() const
+{
+  return latestAdd;
+}
+
+Uint32 Column::LatestChange() const
+{
+  return latestChange;
+}
+
+const Column::Layout& Column::GetLayout() const
+{
+  return layout;
+}
+
+void Column::Grow(Uint32 newCapacity)
+{
+  auto* newData
+      = static_cast<Uint8*>(::operator new(static_cast<Uint64>(newCapacity) * layout.size, std::align_val_t(layout.align)));
+
+  if (layout.trivial && count > 0) {
+    memcpy(newData, data, static_cast<Uint64>(count) * layout.size);
+  }
+  else if (!layout.trivial) {
+    for (Uint32 i = 0; i < count; i++) {
+      layout.move(newData + static_cast<Uint64>(i) * layout.size, At(i));
+      layout.destroy(At(i));
+    }
+  }
+  auto* newAdded = new Uint32[newCapacity];
+  auto* newChanged = new Uint32[newCapacity];
+  std::copy(added, added + count, newAdded);
+  std::copy(changed, changed + count, newChanged);
+  if (owned) {
+    ::operator delete(data, std::align_val_t(layout.align));
+    delete[] added;
+    delete[] changed;
+  }
+
+  data = newData;
+  added = newAdded;
+  changed = newChanged;
+  capacity = newCapacity;
+  owned = true;
+}
+
+Archetype::Archetype(const ComponentMask& signature, const Column::Layout* layouts, Uint32 layoutCount)
+    : signature(signature)
+{
+  for (Uint32 i = 0; i < layoutCount; i++) {
+    columns.Insert(new Column(layouts[i]));
+  }
+}
+
+Archetype::~Archetype()
+{
+  for (Column* column : columns) {
+    delete column;
+  }
+}
+
+Uint32 Archetype::Push(Entity entity)
+{
+  entities.Insert(entity);
+  return entities.Count() - 1;
+}
+
+bool Archetype::SwapRemove(Uint32 row, Entity* moved)
+{
+  for (Column* column : columns) {
+    column->SwapRemove(row);
+  }
+
+  const Uint32 last = entities.Count() - 1;
+  entities[row] = entities[last];
+  entities.OverrideCount(last);
+  if (row == last) {
+    return false;
+  }
+  *moved = entities[row];
+  return true;
+}
+
+Column* Archetype::ColumnOf(const ComponentId id)
+{
+  return signature.Test(id) ? columns[signature.Rank(id)] : nullptr;
+}
+
+Column* Archetype::ColumnAt(Uint32 index)
+{
+  return columns[index];
+}
+
+Uint32 Archetype::ColumnCount() const
+{
+  return columns.Count();
+}
+
+const ComponentMask& Archetype::Signature() const
+{
+  return signature;
+}
+
+Uint32 Archetype::Count() const
+{
+  return entities.Count();
+}
+
+Entity Archetype::EntityAt(Uint32 row) const
+{
+  return entities[row];
+}
+
+const Entity* Archetype::Entities() const
+{
+  return entities.Data();
+}
+
+}  // namespace NycaTech
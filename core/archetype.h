@@ -0,0 +1,142 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef ARCHETYPE_H
+#define ARCHETYPE_H
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "component.h"
+#include "entity.h"
+#include "lib/small_vector.h"
+#include "lib/types.h"
+#include "lib/vector.h"
+
+namespace NycaTech {
+
+// Contiguous, type-erased storage for every component of a single type inside an archetype. Next to every component
+// sits the World change tick it was added at and last changed at; the column also tracks the newest of each, so
+// change-filtered queries can skip it without looking at single rows.
+class Column final {
+public:
+  struct Layout {
+    ComponentId id;
+    Uint64      hash;
+    Uint32      size;
+    Uint32      align;
+    bool        trivial;
+    void (*move)(void* dst, void* src);
+    void (*destroy)(void* elem);
+
+    template <typename T>
+    static Layout Of();
+  };
+
+   explicit Column(const Layout& layout);
+   Column(Column&&) = delete;
+   Column(const Column&) = delete;
+  ~Column();
+
+public:
+  void*         At(Uint32 row);
+  void*         Push(Uint32 tick);
+  void          SwapRemove(Uint32 row);
+  void          MarkChanged(Uint32 row, Uint32 tick);
+  void          Touch(Uint32 tick);
+  bool          Adopt(Uint8* rows, Uint32* addedTicks, Uint32* changedTicks, Uint32 rowCount);
+  Uint32        Count() const;
+  Uint32*       AddedTicks();
+  Uint32*       ChangedTicks();
+  Uint32        LatestAdd() const;
+  Uint32        LatestChange() const;
+  const Layout& GetLayout() const;
+
+  template <typename T>
+  T* Data();
+
+private:
+  void Grow(Uint32 newCapacity);
+
+private:
+  Layout  layout;
+  Uint8*  data;
+  Uint32* added;
+  Uint32* changed;
+  Uint32  count;
+  Uint32  capacity;
+  Uint32  latestAdd;
+  Uint32  latestChange;
+  bool    owned;
+};
+
+// Every entity sharing the same component signature, stored as one column per component type.
+class Archetype final {
+public:
+   Archetype(const ComponentMask& signature, const Column::Layout* layouts, Uint32 layoutCount);
+   Archetype(Archetype&&) = delete;
+   Archetype(const Archetype&) = delete;
+  ~Archetype();
+
+public:
+  Uint32               Push(Entity entity);
+  bool                 SwapRemove(Uint32 row, Entity* moved);
+  Column*              ColumnOf(ComponentId id);
+  Column*              ColumnAt(Uint32 index);
+  Uint32               ColumnCount() const;
+  const ComponentMask& Signature() const;
+  Uint32               Count() const;
+  Entity               EntityAt(Uint32 row) const;
+
+  const Entity* Entities() const;
+
+  template <typename T>
+  Column* ColumnOf();
+  template <typename T>
+  T* Components();
+
+private:
+  ComponentMask           signature;
+  Vector<Entity>          entities;
+  SmallVector<Column*, 8> columns;
+};
+
+template <typename T>
+Column::Layout Column::Layout::Of()
+{
+  static_assert(std::is_base_of_v<Component, T>, "components must derive from Component");
+  return {
+    .id = ComponentIdOf<T>(),
+    .hash = ComponentHashOf<T>(),
+    .size = sizeof(T),
+    .align = alignof(T),
+    .trivial = std::is_trivially_copyable_v<T>,
+    .move = [](void* dst, void* src) { new (dst) T(std::move(*static_cast<T*>(src))); },
+    .destroy = [](void* elem) { static_cast<T*>(elem)->~T(); },
+  };
+}
+
+template <typename T>
+T* Column::Data()
+{
+  return reinterpret_cast<T*>(data);
+}
+
+template <typename T>
+Column* Archetype::ColumnOf()
+{
+  return ColumnOf(ComponentIdOf<T>());
+}
+
+template <typename T>
+T* Archetype::Components()
+{
+  Column* column = ColumnOf<T>();
+  return column ? column->Data<T>() : nullptr;
+}
+
+}  // namespace NycaTech
+
+#endif  // ARCHETYPE_H
@@ -0,0 +1,207 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#include "bench.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+
+#include "lib/assert.h"
+
+namespace NycaTech::Bench {
+
+State::State(Uint64 iterations, Uint64 argument)
+    : elapsed(0),
+      iterations(iterations),
+      remaining(iterations),
+      argument(argument),
+      items(0),
+      started(false),
+      running(false)
+{
+}
+
+bool State::KeepRunning()
+{
+  if (!started) {
+    started = true;
+    ResumeTiming();
+  }
+  if (remaining > 0) {
+    remaining--;
+    return true;
+  }
+  PauseTiming();
+  return false;
+}
+
+void State::PauseTiming()
+{
+  if (running) {
+    elapsed += MonotonicTime::now() - start;
+    running = false;
+  }
+}
+
+void State::ResumeTiming()
+{
+  if (!running) {
+    running = true;
+    start = MonotonicTime::now();
+  }
+}
+
+void State::SetItemsProcessed(Uint64 processed)
+{
+  items = processed;
+}
+
+Uint64 State::Argument() const
+{
+  return argument;
+}
+
+Uint64 State::Iterations() const
+{
+  return iterations;
+}
+
+Uint64 State::ItemsProcessed() const
+{
+  return items;
+}
+
+MonotonicTime::duration State::Elapsed() const
+{
+  return elapsed;
+}
+
+void Suite::Add(const String& name, Body body, std::initializer_list<Uint64> arguments)
+{
+  benchmarks.Insert({ name, std::move(body), Vector<Uint64>(arguments) });
+}
+
+bool Suite::Run(const Options& options)
+{
+  Vector<Result> results;
+  if (!options.json) {
+    printf("%-44s %14s %14s %12s %16s\n", "benchmark", "median ns", "min ns", "iterations", "items/s");
+  }
+  for (const Benchmark& benchmark: benchmarks) {
+    const Uint32 runs = std::max(benchmark.arguments.Count(), 1u);
+    for (Uint32 i = 0; i < runs; i++) {
+      const Uint64 argument = benchmark.arguments.IsEmpty() ? 0 : benchmark.arguments[i];
+      const String name = benchmark.arguments.IsEmpty() ? benchmark.name
+                                                        : benchmark.name + "/" + std::to_string(argument);
+      if (!options.filter.empty() && name.find(options.filter) == String::npos) {
+        continue;
+      }
+
+      const Result result = Measure(name, benchmark.body, argument, options);
+      if (!options.json) {
+        printf("%-44s %14.1f %14.1f %12llu %16.4g\n",
+               result.name.c_str(),
+               result.medianNs,
+               result.minNs,
+               static_cast<unsigned long long>(result.iterations),
+               result.itemsPerSecond);
+        fflush(stdout);
+      }
+      results.Insert(result);
+    }
+  }
+  return !options.json || WriteJson(results, options);
+}
+
+// Doubles the iteration count, or jumps straight to the predicted count once a run is long enough to trust, until a
+// run fills the minimum time. The repetitions then reuse that count.
+Result Suite::Measure(const String& name, const Body& body, Uint64 argument, const Options& options) const
+{
+  Uint64 iterations = 1;
+  for (;;) {
+    State state(iterations, argument);
+    body(state);
+    const Float64 seconds = duration<Float64>(state.Elapsed()).count();
+    if (seconds >= options.minTime || iterations >= 1'000'000'000) {
+      break;
+    }
+    const Float64 predicted = seconds > 0.0 ? options.minTime * 1.2 / seconds * iterations : iterations * 10.0;
+    iterations = static_cast<Uint64>(std::clamp(predicted, iterations * 2.0, iterations * 10.0));
+  }
+
+  Vector<Float64> perIteration;
+  Float64         itemsPerSecond = 0.0;
+  for (Uint32 i = 0; i < std::max(options.repetitions, 1u); i++) {
+    State state(iterations, argument);
+    body(state);
+    const Float64 seconds = duration<Float64>(state.Elapsed()).count();
+    perIteration.Insert(seconds * 1e9 / static_cast<Float64>(iterations));
+    itemsPerSecond += seconds > 0.0 ? static_cast<Float64>(state.ItemsProcessed()) / seconds : 0.0;
+  }
+
+  Float64 total = 0.0;
+  for (const Float64 ns: perIteration) {
+    total += ns;
+  }
+  std::sort(perIteration.begin(), perIteration.end());
+  return {
+    .name = name,
+    .iterations = iterations,
+    .minNs = perIteration[0],
+    .medianNs = perIteration[perIteration.Count() / 2],
+    .meanNs = total / perIteration.Count(),
+    .itemsPerSecond = itemsPerSecond / perIteration.Count(),
+  };
+}
+
+// Writes the results to `jsonPath`, or to stdout without one.
+bool Suite::WriteJson(const Vector<Result>& results, const Options& options) const
+{
+  FILE* out = options.jsonPath.empty() ? stdout : fopen(options.jsonPath.c_str(), "w");
+  if (!out) {
+    ErrorMessage = "unable to open the benchmark output file";
+    return false;
+  }
+
+  char         date[32];
+  const time_t now = time(nullptr);
+  strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+#ifdef NDEBUG
+  const char* build = "release";
+#else
+  const char* build = "debug";
+#endif
+
+  fprintf(out, "{\n  \"context\": {\n");
+  fprintf(out, "    \"date\": \"%s\",\n", date);
+  fprintf(out, "    \"build\": \"%s\",\n", build);
+  fprintf(out, "    \"hardware_concurrency\": %u,\n", Thread::hardware_concurrency());
+  fprintf(out, "    \"min_time\": %g,\n", options.minTime);
+  fprintf(out, "    \"repetitions\": %u\n", options.repetitions);
+  fprintf(out, "  },\n  \"benchmarks\": [");
+  for (Uint32 i = 0; i < results.Count(); i++) {
+    const Result& result = results[i];
+    fprintf(out, "%s\n    {\n", i == 0 ? "" : ",");
+    fprintf(out, "      \"name\": \"%s\",\n", result.name.c_str());
+    fprintf(out, "      \"iterations\": %llu,\n", static_cast<unsigned long long>(result.iterations));
+    fprintf(out, "      \"median_ns\": %.3f,\n", result.medianNs);
+    fprintf(out, "      \"min_ns\": %.3f,\n", result.minNs);
+    fprintf(out, "      \"mean_ns\": %.3f,\n", result.meanNs);
+    fprintf(out, "      \"items_per_second\": %.6g\n", result.itemsPerSecond);
+    fprintf(out, "    }");
+  }
+  fprintf(out, "\n  ]\n}\n");
+
+  const bool ok = !ferror(out);
+  if (out != stdout) {
+    fclose(out);
+  }
+  if (!ok) {
+    ErrorMessage = "unable to write the benchmark output file";
+  }
+  return ok;
+}
+
+}  // namespace NycaTech::Bench
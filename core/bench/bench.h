@@ -0,0 +1,108 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <functional>
+#include <initializer_list>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#include "lib/types.h"
+#include "lib/vector.h"
+
+namespace NycaTech::Bench {
+
+// Makes the compiler assume `value` is read, so the work producing it cannot be optimised away.
+template <typename T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  const volatile void* volatile sink = &value;
+  (void)sink;
+  _ReadWriteBarrier();
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+// Handed to a benchmark body, which does its setup and then loops `while (state.KeepRunning())` over the code being
+// measured. Only time spent inside that loop counts, minus anything between PauseTiming and ResumeTiming.
+class State final {
+public:
+  State(Uint64 iterations, Uint64 argument);
+
+public:
+  bool   KeepRunning();
+  void   PauseTiming();
+  void   ResumeTiming();
+  void   SetItemsProcessed(Uint64 processed);
+  Uint64 Argument() const;
+  Uint64 Iterations() const;
+  Uint64 ItemsProcessed() const;
+
+  MonotonicTime::duration Elapsed() const;
+
+private:
+  MonotonicTime::time_point start;
+  MonotonicTime::duration   elapsed;
+  Uint64                    iterations;
+  Uint64                    remaining;
+  Uint64                    argument;
+  Uint64                    items;
+  bool                      started;
+  bool                      running;
+};
+
+struct Options {
+  String  filter;
+  String  jsonPath;
+  bool    json = false;
+  Float64 minTime = 0.25;
+  Uint32  repetitions = 3;
+};
+
+struct Result {
+  String  name;
+  Uint64  iterations;
+  Float64 minNs;
+  Float64 medianNs;
+  Float64 meanNs;
+  Float64 itemsPerSecond;
+};
+
+// Registered benchmarks. Each one runs once per argument, long enough to fill Options::minTime, and then that many
+// iterations again Options::repetitions times; results report nanoseconds per iteration over the repetitions.
+class Suite final {
+public:
+  using Body = std::function<void(State&)>;
+
+  void Add(const String& name, Body body, std::initializer_list<Uint64> arguments = {});
+  bool Run(const Options& options);
+
+private:
+  struct Benchmark {
+    String         name;
+    Body           body;
+    Vector<Uint64> arguments;
+  };
+
+  Result Measure(const String& name, const Body& body, Uint64 argument, const Options& options) const;
+  bool   WriteJson(const Vector<Result>& results, const Options& options) const;
+
+private:
+  Vector<Benchmark> benchmarks;
+};
+
+void RegisterContainerBenchmarks(Suite& suite);
+void RegisterEcsBenchmarks(Suite& suite);
+void RegisterConcurrencyBenchmarks(Suite& suite);
+void RegisterMathBenchmarks(Suite& suite);
+
+}  // namespace NycaTech::Bench
+
+#endif  // BENCH_H
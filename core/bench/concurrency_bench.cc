@@ -0,0 +1,147 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#include "bench.h"
+#include "lib/mpmc_queue.h"
+#include "lib/spsc_queue.h"
+#include "thread_pool.h"
+
+namespace NycaTech::Bench {
+
+static constexpr Uint32 QueueCapacity = 4096;
+static constexpr Uint32 BatchSize = 64;
+
+// One producer thread pushes `count` items while the calling thread pops them, in batches when the argument says so.
+template <bool Batched>
+static void SpscThroughput(State& state)
+{
+  const auto        count = static_cast<Uint32>(state.Argument());
+  SpscQueue<Uint64> queue(QueueCapacity);
+  while (state.KeepRunning()) {
+    Thread producer([&queue, count] {
+      Uint64 batch[BatchSize];
+      for (Uint32 sent = 0; sent < count;) {
+        if constexpr (Batched) {
+          const Uint32 wanted = std::min(BatchSize, count - sent);
+          for (Uint32 i = 0; i < wanted; i++) {
+            batch[i] = sent + i;
+          }
+          const Uint32 pushed = queue.PushBatch(batch, wanted);
+          sent += pushed;
+          if (pushed == 0) {
+            yield();
+          }
+        }
+        else if (queue.TryPush(sent)) {
+          sent++;
+        }
+        else {
+          yield();
+        }
+      }
+    });
+
+    Uint64 sum = 0;
+    Uint64 batch[BatchSize];
+    for (Uint32 received = 0; received < count;) {
+      const Uint32 popped = Batched ? queue.PopBatch(batch, BatchSize) : queue.TryPop(batch[0]) ? 1 : 0;
+      for (Uint32 i = 0; i < popped; i++) {
+        sum += batch[i];
+      }
+      received += popped;
+      if (popped == 0) {
+        yield();
+      }
+    }
+    producer.join();
+    DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.Iterations() * count);
+}
+
+// Two producers and two consumers share one queue; the calling thread only waits.
+template <bool Batched>
+static void MpmcThroughput(State& state)
+{
+  static constexpr Uint32 Producers = 2;
+  static constexpr Uint32 Consumers = 2;
+
+  const auto        count = static_cast<Uint32>(state.Argument()) / Producers * Producers;
+  MpmcQueue<Uint64> queue(QueueCapacity);
+  while (state.KeepRunning()) {
+    Atomic<Uint64> consumed = 0;
+    Atomic<Uint64> sum = 0;
+    Thread         threads[Producers + Consumers];
+    for (Uint32 p = 0; p < Producers; p++) {
+      threads[p] = Thread([&queue, count] {
+        Uint64 batch[BatchSize];
+        for (Uint32 sent = 0; sent < count / Producers;) {
+          Uint32 pushed;
+          if constexpr (Batched) {
+            const Uint32 wanted = std::min(BatchSize, count / Producers - sent);
+            for (Uint32 i = 0; i < wanted; i++) {
+              batch[i] = sent + i;
+            }
+            pushed = queue.PushBatch(batch, wanted);
+          }
+          else {
+            pushed = queue.TryPush(sent) ? 1 : 0;
+          }
+          sent += pushed;
+          if (pushed == 0) {
+            yield();
+          }
+        }
+      });
+    }
+    for (Uint32 c = 0; c < Consumers; c++) {
+      threads[Producers + c] = Thread([&queue, &consumed, &sum, count] {
+        Uint64 batch[BatchSize];
+        Uint64 local = 0;
+        while (consumed.load(std::memory_order_relaxed) < count) {
+          const Uint32 popped = Batched ? queue.PopBatch(batch, BatchSize) : queue.TryPop(batch[0]) ? 1 : 0;
+          for (Uint32 i = 0; i < popped; i++) {
+            local += batch[i];
+          }
+          if (popped == 0) {
+            yield();
+          }
+          consumed.fetch_add(popped, std::memory_order_relaxed);
+        }
+        sum.fetch_add(local, std::memory_order_relaxed);
+      });
+    }
+    for (Thread& thread: threads) {
+      thread.join();
+    }
+    DoNotOptimize(sum.load());
+  }
+  state.SetItemsProcessed(state.Iterations() * count);
+}
+
+// Submits empty jobs against a counter and waits for all of them, which is the job system's per-job overhead.
+static void SubmitAndWait(State& state)
+{
+  const auto  count = static_cast<Uint32>(state.Argument());
+  ThreadPool& pool = ThreadPool::Shared();
+  while (state.KeepRunning()) {
+    JobCounter counter;
+    for (Uint32 i = 0; i < count; i++) {
+      pool.Submit([] {}, counter);
+    }
+    pool.WaitFor(counter);
+  }
+  state.SetItemsProcessed(state.Iterations() * count);
+}
+
+void RegisterConcurrencyBenchmarks(Suite& suite)
+{
+  suite.Add("SpscQueue/Throughput", SpscThroughput<false>, { 1'000'000 });
+  suite.Add("SpscQueue/BatchThroughput", SpscThroughput<true>, { 1'000'000 });
+  suite.Add("MpmcQueue/Throughput", MpmcThroughput<false>, { 1'000'000 });
+  suite.Add("MpmcQueue/BatchThroughput", MpmcThroughput<true>, { 1'000'000 });
+  suite.Add("ThreadPool/SubmitAndWait", SubmitAndWait, { 1'000, 100'000 });
+}
+
+}  // namespace NycaTech::Bench
@@ -0,0 +1,231 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "bench.h"
+#include "lib/hash_map.h"
+#include "lib/small_vector.h"
+#include "lib/sparse_set.h"
+#include "lib/vector.h"
+
+namespace NycaTech::Bench {
+
+// Distinct pseudo-random keys, so hash maps see neither sequential nor colliding input.
+static Vector<Uint64> RandomKeys(Uint32 count, Uint64 seed)
+{
+  std::mt19937_64 random(seed);
+  Vector<Uint64>  keys;
+  keys.Reserve(count);
+  for (Uint32 i = 0; i < count; i++) {
+    keys.Insert(random() | 1);
+  }
+  return keys;
+}
+
+static void VectorInsert(State& state)
+{
+  const auto count = static_cast<Uint32>(state.Argument());
+  while (state.KeepRunning()) {
+    Vector<Uint32> vector;
+    for (Uint32 i = 0; i < count; i++) {
+      vector.Insert(i);
+    }
+    DoNotOptimize(vector.Data());
+  }
+  state.SetItemsProcessed(state.Iterations() * count);
+}
+
+static void StdVectorInsert(State& state)
+{
+  const auto count = static_cast<Uint32>(state.Argument());
+  while (state.KeepRunning()) {
+    std::vector<Uint32> vector;
+    for (Uint32 i = 0; i < count; i++) {
+      vector.push_back(i);
+    }
+    DoNotOptimize(vector.data());
+  }
+  state.SetItemsProcessed(state.Iterations() * count);
+}
+
+static void SmallVectorInsert(State& state)
+{
+  const auto count = static_cast<Uint32>(state.Argument());
+  while (state.KeepRunning()) {
+    SmallVector<Uint32, 16> vector;
+    for (Uint32 i = 0; i < count; i++) {
+      vector.Insert(i);
+    }
+    DoNotOptimize(vector.Data());
+  }
+  state.SetItemsProcessed(state.Iterations() * count);
+}
+
+static void VectorIterate(State& state)
+{
+  const auto     count = static_cast<Uint32>(state.Argument());
+  Vector<Uint32> vector;
+  for (Uint32 i = 0; i < count; i++) {
+    vector.Insert(i);
+  }
+  while (state.KeepRunning()) {
+    Uint64 sum = 0;
+    for (const Uint32 value: vector) {
+      sum += value;
+    }
+    DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.Iterations() * count);
+}
+
+static void VectorCopy(State& state)
+{
+  const auto     count = static_cast<Uint32>(state.Argument());
+  Vector<Uint32> vector;
+  for (Uint32 i = 0; i < count; i++) {
+    vector.Insert(i);
+  }
+  while (state.KeepRunning()) {
+    Vector<Uint32> copy(vector);
+    DoNotOptimize(copy.Data());
+  }
+  state.SetItemsProcessed(state.Iterations() * count);
+}
+
+static void VectorCopyStrings(State& state)
+{
+  const auto     count = static_cast<Uint32>(state.Argument());
+  Vector<String> vector;
+  for (Uint32 i = 0; i < count; i++) {
+    vector.Insert("component-name-" + std::to_string(i));
+  }
+  while (state.KeepRunning()) {
+    Vector<String> copy(vector);
+    DoNotOptimize(copy.Data());
+  }
+  state.SetItemsProcessed(state.Iterations() * count);
+}
+
+static void HashMapInsert(State& state)
+{
+  const auto           count = static_cast<Uint32>(state.Argument());
+  const Vector<Uint64> keys = RandomKeys(count, 1);
+  while (state.KeepRunning()) {
+    HashMap<Uint64, Uint64> map;
+    for (const Uint64 key: keys) {
+      map[key] = key;
+    }
+    DoNotOptimize(map.Count());
+  }
+  state.SetItemsProcessed(state.Iterations() * count);
+}
+
+static void StdUnorderedMapInsert(State& state)
+{
+  const auto           count = static_cast<Uint32>(state.Argument());
+  const Vector<Uint64> keys = RandomKeys(count, 1);
+  while (state.KeepRunning()) {
+    std::unordered_map<Uint64, Uint64> map;
+    for (const Uint64 key: keys) {
+      map[key] = key;
+    }
+    DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.Iterations() * count);
+}
+
+// Looks every key up once per iteration, in an order unrelated to insertion. Misses use keys that were never added.
+template <bool Hit>
+static void HashMapLookup(State& state)
+{
+  const auto              count = static_cast<Uint32>(state.Argument());
+  const Vector<Uint64>    keys = RandomKeys(count, 1);
+  const Vector<Uint64>    probes = Hit ? RandomKeys(count, 1) : RandomKeys(count, 2);
+  HashMap<Uint64, Uint64> map;
+  for (const Uint64 key: keys) {
+    map[key] = key;
+  }
+  Vector<Uint32> order;
+  for (Uint32 i = 0; i < count; i++) {
+    order.Insert(i);
+  }
+  std::shuffle(order.begin(), order.end(), std::mt19937(3));
+
+  while (state.KeepRunning()) {
+    Uint64 found = 0;
+    for (const Uint32 i: order) {
+      const Uint64* value = map.Find(probes[i]);
+      found += value ? *value : 0;
+    }
+    DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.Iterations() * count);
+}
+
+template <bool Hit>
+static void StdUnorderedMapLookup(State& state)
+{
+  const auto                         count = static_cast<Uint32>(state.Argument());
+  const Vector<Uint64>               keys = RandomKeys(count, 1);
+  const Vector<Uint64>               probes = Hit ? RandomKeys(count, 1) : RandomKeys(count, 2);
+  std::unordered_map<Uint64, Uint64> map;
+  for (const Uint64 key: keys) {
+    map[key] = key;
+  }
+  Vector<Uint32> order;
+  for (Uint32 i = 0; i < count; i++) {
+    order.Insert(i);
+  }
+  std::shuffle(order.begin(), order.end(), std::mt19937(3));
+
+  while (state.KeepRunning()) {
+    Uint64 found = 0;
+    for (const Uint32 i: order) {
+      const auto it = map.find(probes[i]);
+      found += it != map.end() ? it->second : 0;
+    }
+    DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.Iterations() * count);
+}
+
+// Inserts every other key and erases it again, the pattern a sparse component pool sees.
+static void SparseSetChurn(State& state)
+{
+  const auto        count = static_cast<Uint32>(state.Argument());
+  SparseSet<Uint64> set;
+  while (state.KeepRunning()) {
+    for (Uint32 key = 0; key < count; key += 2) {
+      set.Insert(key, key);
+    }
+    for (Uint32 key = 0; key < count; key += 2) {
+      set.Erase(key);
+    }
+    DoNotOptimize(set.Count());
+  }
+  state.SetItemsProcessed(state.Iterations() * count);
+}
+
+void RegisterContainerBenchmarks(Suite& suite)
+{
+  suite.Add("Vector/Insert", VectorInsert, { 1'000, 100'000, 1'000'000 });
+  suite.Add("StdVector/Insert", StdVectorInsert, { 1'000, 100'000, 1'000'000 });
+  suite.Add("SmallVector/Insert", SmallVectorInsert, { 8, 1'000 });
+  suite.Add("Vector/Iterate", VectorIterate, { 1'000, 100'000, 1'000'000 });
+  suite.Add("Vector/Copy", VectorCopy, { 1'000, 100'000, 1'000'000 });
+  suite.Add("Vector/CopyStrings", VectorCopyStrings, { 1'000, 100'000 });
+  suite.Add("HashMap/Insert", HashMapInsert, { 1'000, 100'000, 1'000'000 });
+  suite.Add("StdUnorderedMap/Insert", StdUnorderedMapInsert, { 1'000, 100'000, 1'000'000 });
+  suite.Add("HashMap/LookupHit", HashMapLookup<true>, { 1'000, 100'000, 1'000'000 });
+  suite.Add("StdUnorderedMap/LookupHit", StdUnorderedMapLookup<true>, { 1'000, 100'000, 1'000'000 });
+  suite.Add("HashMap/LookupMiss", HashMapLookup<false>, { 1'000, 100'000, 1'000'000 });
+  suite.Add("StdUnorderedMap/LookupMiss", StdUnorderedMapLookup<false>, { 1'000, 100'000, 1'000'000 });
+  suite.Add("SparseSet/Churn", SparseSetChurn, { 1'000, 100'000 });
+}
+
+}  // namespace NycaTech::Bench
@@ -0,0 +1,141 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#include "bench.h"
+#include "world.h"
+
+namespace NycaTech::Bench {
+
+struct Velocity final : Component {
+  float x = 1.0f;
+  float y = 0.0f;
+  float z = 0.5f;
+};
+
+struct Health final : Component {
+  Int32 value = 100;
+};
+
+// Moves every entity along its velocity, so each tick also feeds every transform through the spatial index.
+class Integrate final : public System {
+public:
+  ComponentMask Reads() const override { return World::SignatureOf<Velocity>(); }
+  ComponentMask Writes() const override { return World::SignatureOf<TransformComponent>(); }
+
+  void Run(World& world, float delta) override
+  {
+    world.ParallelForEach<TransformComponent, const Velocity>(
+        [delta](TransformComponent& transform, const Velocity& velocity) {
+          transform.transform.position[0] += velocity.x * delta;
+          transform.transform.position[1] += velocity.y * delta;
+          transform.transform.position[2] += velocity.z * delta;
+        });
+  }
+};
+
+class Regenerate final : public System {
+public:
+  ComponentMask Writes() const override { return World::SignatureOf<Health>(); }
+
+  void Run(World& world, float) override
+  {
+    world.ForEach<Health>([](Health& health) { health.value = std::min(health.value + 1, 100); });
+  }
+};
+
+static Transform Placement(Uint32 index)
+{
+  Transform transform;
+  transform.position = { static_cast<float>(index % 1000), static_cast<float>(index / 1000), 0.0f };
+  return transform;
+}
+
+static void SpawnEntities(State& state)
+{
+  const auto count = static_cast<Uint32>(state.Argument());
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    auto* world = new World();
+    state.ResumeTiming();
+    for (Uint32 i = 0; i < count; i++) {
+      world->Spawn(TransformComponent(Placement(i)), Velocity());
+    }
+    state.PauseTiming();
+    delete world;
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.Iterations() * count);
+}
+
+// Adds and removes a component on every entity, moving each between two archetypes and back.
+static void AddRemoveComponent(State& state)
+{
+  const auto     count = static_cast<Uint32>(state.Argument());
+  World          world;
+  Vector<Entity> entities;
+  for (Uint32 i = 0; i < count; i++) {
+    entities.Insert(world.Spawn(TransformComponent(Placement(i)), Velocity()));
+  }
+  while (state.KeepRunning()) {
+    for (const Entity entity: entities) {
+      world.AddComponent(entity, Health());
+    }
+    for (const Entity entity: entities) {
+      world.RemoveComponent<Health>(entity);
+    }
+  }
+  state.SetItemsProcessed(state.Iterations() * count * 2);
+}
+
+static void ForEach(State& state)
+{
+  const auto count = static_cast<Uint32>(state.Argument());
+  World      world;
+  for (Uint32 i = 0; i < count; i++) {
+    world.Spawn(TransformComponent(Placement(i)), Velocity());
+  }
+  while (state.KeepRunning()) {
+    float sum = 0.0f;
+    world.ForEach<const TransformComponent, const Velocity>(
+        [&sum](const TransformComponent& transform, const Velocity& velocity) {
+          sum += transform.transform.position[0] * velocity.x;
+        });
+    DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.Iterations() * count);
+}
+
+static void WorldTick(State& state)
+{
+  const auto count = static_cast<Uint32>(state.Argument());
+  World      world;
+  Integrate  integrate;
+  Regenerate regenerate;
+  world.AddSystem(&integrate);
+  world.AddSystem(&regenerate);
+  for (Uint32 i = 0; i < count; i++) {
+    if (i % 4 == 0) {
+      world.Spawn(TransformComponent(Placement(i)), Velocity(), Health());
+    }
+    else {
+      world.Spawn(TransformComponent(Placement(i)), Velocity());
+    }
+  }
+  world.Tick(1.0f / 60.0f);
+
+  while (state.KeepRunning()) {
+    world.Tick(1.0f / 60.0f);
+  }
+  state.SetItemsProcessed(state.Iterations() * count);
+}
+
+void RegisterEcsBenchmarks(Suite& suite)
+{
+  suite.Add("World/Spawn", SpawnEntities, { 1'000, 100'000, 1'000'000 });
+  suite.Add("World/AddRemoveComponent", AddRemoveComponent, { 1'000, 100'000 });
+  suite.Add("World/ForEach", ForEach, { 1'000, 100'000, 1'000'000 });
+  suite.Add("World/Tick", WorldTick, { 1'000, 100'000, 1'000'000 });
+}
+
+}  // namespace NycaTech::Bench
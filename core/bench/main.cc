@@ -0,0 +1,63 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "bench.h"
+#include "lib/assert.h"
+
+using namespace NycaTech;
+using namespace NycaTech::Bench;
+
+static const char* Usage = "usage: NycaTechBench [--filter=<substring>] [--json[=<path>]] [--min-time=<seconds>]"
+                           " [--repetitions=<count>]\n";
+
+static bool ParseOptions(int argc, char* argv[], Options& options)
+{
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    if (strncmp(arg, "--filter=", 9) == 0) {
+      options.filter = arg + 9;
+    }
+    else if (strcmp(arg, "--json") == 0) {
+      options.json = true;
+    }
+    else if (strncmp(arg, "--json=", 7) == 0) {
+      options.json = true;
+      options.jsonPath = arg + 7;
+    }
+    else if (strncmp(arg, "--min-time=", 11) == 0) {
+      options.minTime = atof(arg + 11);
+    }
+    else if (strncmp(arg, "--repetitions=", 14) == 0) {
+      options.repetitions = static_cast<Uint32>(atoi(arg + 14));
+    }
+    else {
+      return false;
+    }
+  }
+  return options.minTime > 0.0 && options.repetitions > 0;
+}
+
+int main(int argc, char* argv[])
+{
+  Options options;
+  if (!ParseOptions(argc, argv, options)) {
+    fputs(Usage, stderr);
+    return 2;
+  }
+
+  Suite suite;
+  RegisterContainerBenchmarks(suite);
+  RegisterEcsBenchmarks(suite);
+  RegisterConcurrencyBenchmarks(suite);
+  RegisterMathBenchmarks(suite);
+  if (!suite.Run(options)) {
+    fprintf(stderr, "%s\n", ErrorMessage);
+    return 1;
+  }
+  return 0;
+}
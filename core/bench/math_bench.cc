@@ -0,0 +1,71 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#include "bench.h"
+#include "lib/linear_algebra.h"
+
+namespace NycaTech::Bench {
+
+static Vector<Transform> Transforms(Uint32 count)
+{
+  Vector<Transform> transforms;
+  for (Uint32 i = 0; i < count; i++) {
+    const Math::Quat rotation = Math::FromAxisAngle({ 0.0f, 1.0f, 0.0f }, static_cast<float>(i) * 0.01f);
+    transforms.Insert(Transform({ static_cast<float>(i), 0.0f, 1.0f },
+                                { rotation.x, rotation.y, rotation.z, rotation.w },
+                                { 1.0f, 2.0f, 1.0f }));
+  }
+  return transforms;
+}
+
+static void ComposeBatch(State& state)
+{
+  const auto              count = static_cast<Uint32>(state.Argument());
+  const Vector<Transform> transforms = Transforms(count);
+  Vector<Math::Mat4>      matrices(count);
+  while (state.KeepRunning()) {
+    Math::Compose(transforms.Data(), matrices.Data(), count);
+    DoNotOptimize(matrices.Data());
+  }
+  state.SetItemsProcessed(state.Iterations() * count);
+}
+
+static void TransformPointsBatch(State& state)
+{
+  const auto       count = static_cast<Uint32>(state.Argument());
+  const Math::Mat4 matrix = Math::Compose(Transforms(1)[0]);
+  Vector<float>    points(count * 3);
+  Vector<float>    transformed(count * 3);
+  for (Uint32 i = 0; i < count * 3; i++) {
+    points[i] = static_cast<float>(i % 97);
+  }
+  while (state.KeepRunning()) {
+    Math::TransformPoints(matrix, points.Data(), transformed.Data(), count);
+    DoNotOptimize(transformed.Data());
+  }
+  state.SetItemsProcessed(state.Iterations() * count);
+}
+
+static void MultiplyBatch(State& state)
+{
+  const auto         count = static_cast<Uint32>(state.Argument());
+  const Math::Mat4   view = Math::LookAt({ 0.0f, 5.0f, 10.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f });
+  Vector<Math::Mat4> models(count);
+  Vector<Math::Mat4> out(count);
+  Math::Compose(Transforms(count).Data(), models.Data(), count);
+  while (state.KeepRunning()) {
+    Math::Multiply(view, models.Data(), out.Data(), count);
+    DoNotOptimize(out.Data());
+  }
+  state.SetItemsProcessed(state.Iterations() * count);
+}
+
+void RegisterMathBenchmarks(Suite& suite)
+{
+  suite.Add("Math/Compose", ComposeBatch, { 1'000, 100'000 });
+  suite.Add("Math/TransformPoints", TransformPointsBatch, { 1'000, 100'000 });
+  suite.Add("Math/Multiply", MultiplyBatch, { 1'000, 100'000 });
+}
+
+}  // namespace NycaTech::Bench
@@ -0,0 +1,57 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#include "command_buffer.h"
+
+#include "lib/pair.h"
+#include "world.h"
+
+namespace NycaTech {
+
+CommandBuffer::CommandBuffer()
+    : payloads(BlockSize)
+{
+}
+
+CommandBuffer::~CommandBuffer()
+{
+  for (const Command& command : commands) {
+    command.discard(command.payload);
+  }
+}
+
+void CommandBuffer::Despawn(Entity entity)
+{
+  Record(entity, [](World& world, void* payload) { world.Despawn(*static_cast<Entity*>(payload)); });
+}
+
+void CommandBuffer::RemoveComponent(Entity entity, ComponentId id)
+{
+  Record(Pair<Entity, ComponentId>{ entity, id }, [](World& world, void* payload) {
+    const auto& [target, removed] = *static_cast<Pair<Entity, ComponentId>*>(payload);
+    world.RemoveComponent(target, removed);
+  });
+}
+
+void CommandBuffer::Apply(World& world)
+{
+  for (const Command& command : commands) {
+    command.apply(world, command.payload);
+    command.discard(command.payload);
+  }
+  Reset();
+}
+
+bool CommandBuffer::IsEmpty() const
+{
+  return commands.IsEmpty();
+}
+
+void CommandBuffer::Reset()
+{
+  commands.OverrideCount(0);
+  payloads.Reset();
+}
+
+}  // namespace NycaTech
@@ -0,0 +1,76 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef COMMAND_BUFFER_H
+#define COMMAND_BUFFER_H
+
+#include <new>
+#include <tuple>
+#include <utility>
+
+#include "component.h"
+#include "entity.h"
+#include "lib/linear_arena.h"
+#include "lib/types.h"
+#include "lib/vector.h"
+
+namespace NycaTech {
+
+class World;
+
+// Structural changes recorded while systems run and replayed on the World at the next sync point. Payloads are placed
+// in a LinearArena that is reset after each replay, so recording costs no allocation once the buffer has warmed up.
+class CommandBuffer final {
+public:
+   CommandBuffer();
+   CommandBuffer(CommandBuffer&&) = delete;
+   CommandBuffer(const CommandBuffer&) = delete;
+  ~CommandBuffer();
+
+public:
+  template <typename... Ts>
+  void Spawn(Ts... components);
+  template <typename T>
+  void AddComponent(Entity entity, T component);
+  template <typename T>
+  void RemoveComponent(Entity entity);
+  void Despawn(Entity entity);
+  void RemoveComponent(Entity entity, ComponentId id);
+  void Apply(World& world);
+  bool IsEmpty() const;
+
+  static constexpr Uint32 BlockSize = 16 * 1024;
+
+private:
+  struct Command {
+    void (*apply)(World& world, void* payload);
+    void (*discard)(void* payload);
+    void* payload;
+  };
+
+  template <typename P>
+  void Record(P payload, void (*apply)(World&, void*));
+  void Reset();
+
+private:
+  Vector<Command> commands;
+  LinearArena     payloads;
+};
+
+template <typename P>
+void CommandBuffer::Record(P payload, void (*apply)(World&, void*))
+{
+  void* storage = new (payloads.Allocate(sizeof(P), alignof(P))) P(std::move(payload));
+  commands.Insert({ apply, [](void* stored) { static_cast<P*>(stored)->~P(); }, storage });
+}
+
+template <typename T>
+void CommandBuffer::RemoveComponent(Entity entity)
+{
+  RemoveComponent(entity, ComponentIdOf<T>());
+}
+
+}  // namespace NycaTech
+
+#endif  // COMMAND_BUFFER_H
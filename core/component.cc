@@ -6,21 +6,21 @@
 
 namespace NycaTech {
 
-Component::Component(const Type type)
-  : type(type)
-{
-}
+static Atomic<Uint32> registered = 0;
 
-bool Component::is_a(Type other) const
+ComponentId ComponentRegistry::Next()
 {
-  const auto this_type = static_cast<Uint32>(type);
-  const auto other_type = static_cast<Uint32>(other);
-  return this_type & other_type;
+  const ComponentId id = registered.fetch_add(1, std::memory_order_relaxed);
+  // Checked in every build: an id past the mask would write beyond ComponentMask::words.
+  if (id >= MaxComponents) {
+    throw RuntimeError("more component types than MaxComponents");
+  }
+  return id;
 }
 
-Component::Type Component::get_type() const
+Uint32 ComponentRegistry::Count()
 {
-  return type;
+  return registered.load(std::memory_order_relaxed);
 }
 
-}  // namespace NycaTech
\ No newline at end of file
+}  // namespace NycaTech
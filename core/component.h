@@ -5,30 +5,204 @@
 #ifndef COMPONENT_H
 #define COMPONENT_H
 
+#include <bit>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
 #include "lib/types.h"
 
 namespace NycaTech {
 
-class Component {
+using ComponentId = Uint32;
+
+constexpr Uint32 MaxComponents = 256;
+
+// Concrete components derive from Component; nothing else is needed to store them. Each type is told apart by its id,
+// handed out the first time ComponentIdOf asks for it, and by a hash of its name that is known at compile time and
+// stays the same between runs of one build. Components that are added and removed far more often than they are
+// iterated alongside others, such as short-lived status flags, can declare `static constexpr bool Sparse = true` to
+// live in a per-type sparse set instead; adding or removing them then leaves the entity's archetype alone.
+class Component {};
+
+template <typename T>
+concept SparseComponent = requires { requires T::Sparse; };
+
+// Set of component ids, one bit per id. Archetype signatures, queries and system read / write sets are masks.
+class ComponentMask final {
 public:
-  enum class Type : Uint32 {
-    None = 1 << 0,
-    Render = 1 << 1,
-    AI = 1 << 2,
-    Network = 1 << 3,
-    Physics = 1 << 4,
-    MAX = 1 << 31 - 1,
-  };
+  constexpr ComponentMask() = default;
+
+  static constexpr ComponentMask All();
+
+  constexpr void   Set(ComponentId id);
+  constexpr void   Reset(ComponentId id);
+  constexpr bool   Test(ComponentId id) const;
+  constexpr bool   Contains(const ComponentMask& other) const;
+  constexpr bool   Intersects(const ComponentMask& other) const;
+  constexpr bool   IsEmpty() const;
+  constexpr Uint32 Count() const;
+  // Number of set ids below `id`, which is the column an archetype keeps `id` in.
+  constexpr Uint32 Rank(ComponentId id) const;
+  constexpr Uint64 Hash() const;
+
+  constexpr ComponentMask operator|(const ComponentMask& other) const;
+  constexpr ComponentMask operator&(const ComponentMask& other) const;
+  constexpr bool          operator==(const ComponentMask& other) const = default;
 
-  explicit Component(Type type);
+private:
+  static constexpr Uint32 WordCount = MaxComponents / 64;
+
+  Uint64 words[WordCount] = {};
+};
 
-  bool is_a(Type other) const;
-  Type get_type() const;
+// Hands out dense ids, one per component type, in the order types are first used.
+class ComponentRegistry final {
+public:
+  template <typename T>
+  static ComponentId Id();
+  static Uint32      Count();
 
 private:
-  Type type;
+  static ComponentId Next();
 };
 
+template <typename T>
+ComponentId ComponentIdOf()
+{
+  return ComponentRegistry::Id<std::remove_cv_t<T>>();
+}
+
+// FNV-1a over the compiler's spelling of T. Stable for one compiler, so snapshots use it to name their columns.
+template <typename T>
+constexpr Uint64 ComponentHashOf()
+{
+#if defined(_MSC_VER)
+  constexpr std::string_view name = __FUNCSIG__;
+#else
+  constexpr std::string_view name = __PRETTY_FUNCTION__;
+#endif
+  Uint64 hash = 0xCBF29CE484222325ull;
+  for (const char c: name) {
+    hash = (hash ^ static_cast<Uint8>(c)) * 0x100000001B3ull;
+  }
+  return hash;
+}
+
+// True when no type appears twice in Ts.
+template <typename... Ts>
+struct DistinctComponents : std::true_type {};
+
+template <typename T, typename... Ts>
+struct DistinctComponents<T, Ts...>
+    : std::bool_constant<(!std::is_same_v<T, Ts> && ...) && DistinctComponents<Ts...>::value> {};
+
+template <typename T>
+ComponentId ComponentRegistry::Id()
+{
+  static const ComponentId id = Next();
+  return id;
+}
+
+constexpr ComponentMask ComponentMask::All()
+{
+  ComponentMask mask;
+  for (Uint64& word: mask.words) {
+    word = ~0ull;
+  }
+  return mask;
+}
+
+constexpr void ComponentMask::Set(const ComponentId id)
+{
+  words[id / 64] |= 1ull << (id % 64);
+}
+
+constexpr void ComponentMask::Reset(const ComponentId id)
+{
+  words[id / 64] &= ~(1ull << (id % 64));
+}
+
+constexpr bool ComponentMask::Test(const ComponentId id) const
+{
+  return words[id / 64] & (1ull << (id % 64));
+}
+
+constexpr bool ComponentMask::Contains(const ComponentMask& other) const
+{
+  for (Uint32 i = 0; i < WordCount; i++) {
+    if ((words[i] & other.words[i]) != other.words[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+constexpr bool ComponentMask::Intersects(const ComponentMask& other) const
+{
+  for (Uint32 i = 0; i < WordCount; i++) {
+    if (words[i] & other.words[i]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+constexpr bool ComponentMask::IsEmpty() const
+{
+  return !Intersects(All());
+}
+
+constexpr Uint32 ComponentMask::Count() const
+{
+  Uint32 count = 0;
+  for (const Uint64 word: words) {
+    count += std::popcount(word);
+  }
+  return count;
+}
+
+constexpr Uint32 ComponentMask::Rank(const ComponentId id) const
+{
+  Uint32 rank = 0;
+  for (Uint32 i = 0; i < id / 64; i++) {
+    rank += std::popcount(words[i]);
+  }
+  return rank + std::popcount(words[id / 64] & ((1ull << (id % 64)) - 1));
+}
+
+constexpr Uint64 ComponentMask::Hash() const
+{
+  Uint64 hash = 0;
+  for (const Uint64 word: words) {
+    hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+  }
+  return hash;
+}
+
+constexpr ComponentMask ComponentMask::operator|(const ComponentMask& other) const
+{
+  ComponentMask mask;
+  for (Uint32 i = 0; i < WordCount; i++) {
+    mask.words[i] = words[i] | other.words[i];
+  }
+  return mask;
+}
+
+constexpr ComponentMask ComponentMask::operator&(const ComponentMask& other) const
+{
+  ComponentMask mask;
+  for (Uint32 i = 0; i < WordCount; i++) {
+    mask.words[i] = words[i] & other.words[i];
+  }
+  return mask;
+}
+
 }  // namespace NycaTech
 
+template <>
+struct std::hash<NycaTech::ComponentMask> {
+  size_t operator()(const NycaTech::ComponentMask& mask) const { return mask.Hash(); }
+};
+
 #endif  // COMPONENT_H
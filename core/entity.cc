@@ -6,35 +6,24 @@
 
 namespace NycaTech {
 
-
-Vector<Component*>& Entity::ComponentsOfType(Component::Type type)
-{
-  return components[type];
-}
-
-Entity::~Entity()
+Uint64 Entity::Bits() const
 {
-  for (const auto [key, component_vector] : components) {
-    for (const auto& component : component_vector) {
-      delete component;
-    }
-  }
+  return static_cast<Uint64>(generation) << 32 | index;
 }
 
-Entity::Builder::Builder()
-    : toBuild(new Entity)
+Entity Entity::FromBits(Uint64 bits)
 {
+  return { static_cast<Uint32>(bits), static_cast<Uint32>(bits >> 32) };
 }
 
-Entity::Builder& Entity::Builder::AddComponent(Component* component)
+bool Entity::operator==(const Entity& other) const
 {
-  toBuild->components[component->get_type()].Insert(component);
-  return Self;
+  return index == other.index && generation == other.generation;
 }
 
-Entity* Entity::Builder::Build()
+bool Entity::operator!=(const Entity& other) const
 {
-  return toBuild;
+  return !(Self == other);
 }
 
-}  // namespace NycaTech
\ No newline at end of file
+}  // namespace NycaTech
@@ -5,38 +5,25 @@
 #ifndef ENTITY_H
 #define ENTITY_H
 
-#include "component.h"
-#include "lib/vector.h"
+#include "lib/types.h"
 
 namespace NycaTech {
 
-class Entity final {
-public:
-  class Builder final {
-  public:
-     Builder();
-    ~Builder() = default;
+// Generational handle into the World's entity slots. A slot bumps its generation when the entity living in it is
+// despawned, so handles kept past that point stop resolving instead of aliasing whatever reuses the slot.
+struct Entity final {
+  Uint32 index;
+  Uint32 generation;
 
-  public:
-    Builder& AddComponent(Component* component);
-    Entity*  Build();
+  Uint64        Bits() const;
+  static Entity FromBits(Uint64 bits);
 
-  private:
-    Entity* toBuild;
-  };
-
-  ~Entity();
-
-public:
-  Vector<Component*>& ComponentsOfType(Component::Type);
-
-private:
-  explicit Entity() = default;
-
-private:
-  HashMap<Component::Type, Vector<Component*>> components;
+  bool operator==(const Entity& other) const;
+  bool operator!=(const Entity& other) const;
 };
 
+inline constexpr Entity NullEntity{ UINT32_MAX, UINT32_MAX };
+
 }  // namespace NycaTech
 
 #endif  // ENTITY_H
@@ -0,0 +1,85 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#include "frame_pacer.h"
+
+#include <cmath>
+
+namespace NycaTech {
+
+FramePacer::FramePacer(MonotonicTime::duration period)
+    : period(period), deadline(), stats(), sleepMean(0.002), sleepM2(0.0), sleepSamples(1)
+{
+}
+
+void FramePacer::Begin()
+{
+  deadline = MonotonicTime::now() + period;
+}
+
+void FramePacer::Wait()
+{
+  const auto now = MonotonicTime::now();
+  stats.frames++;
+  if (now > deadline) {
+    // Late frames resynchronise instead of rushing the following ones to make up for lost time.
+    const auto lateness = now - deadline;
+    stats.missedDeadlines++;
+    stats.totalLateness += lateness;
+    stats.worstLateness = std::max(stats.worstLateness, lateness);
+    deadline = now + period;
+    return;
+  }
+
+  SleepUntil(deadline);
+  deadline += period;
+}
+
+void FramePacer::SetPeriod(MonotonicTime::duration newPeriod)
+{
+  period = newPeriod;
+}
+
+MonotonicTime::duration FramePacer::Period() const
+{
+  return period;
+}
+
+const FramePacer::Stats& FramePacer::GetStats() const
+{
+  return stats;
+}
+
+void FramePacer::ResetStats()
+{
+  stats = {};
+}
+
+void FramePacer::SleepUntil(MonotonicTime::time_point target)
+{
+  // Sleep in 1ms slices while the remaining time exceeds the expected cost of one, tracked with Welford's running
+  // mean/variance of how long those sleeps really took.
+  for (;;) {
+    const Float64 remaining = duration<Float64>(target - MonotonicTime::now()).count();
+    const Float64 estimate = sleepMean + std::sqrt(sleepM2 / sleepSamples);
+    if (remaining <= estimate) {
+      break;
+    }
+
+    const auto start = MonotonicTime::now();
+    sleep_for(milliseconds(1));
+    const Float64 observed = duration<Float64>(MonotonicTime::now() - start).count();
+
+    sleepSamples++;
+    const Float64 delta = observed - sleepMean;
+    sleepMean += delta / sleepSamples;
+    sleepM2 += delta * (observed - sleepMean);
+  }
+
+  while (MonotonicTime::now() < target) {
+    yield();
+  }
+}
+
+}  // namespace NycaTech
@@ -0,0 +1,47 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include "lib/types.h"
+
+namespace NycaTech {
+
+// Holds a loop to a fixed period. Wait() sleeps while the OS scheduler can be trusted to wake it up in time and spins
+// through the last stretch, learning from every sleep how late the OS tends to be.
+class FramePacer final {
+public:
+  struct Stats {
+    Uint64                  frames;
+    Uint64                  missedDeadlines;
+    MonotonicTime::duration worstLateness;
+    MonotonicTime::duration totalLateness;
+  };
+
+  explicit FramePacer(MonotonicTime::duration period);
+
+public:
+  void                    Begin();
+  void                    Wait();
+  void                    SetPeriod(MonotonicTime::duration newPeriod);
+  MonotonicTime::duration Period() const;
+  const Stats&            GetStats() const;
+  void                    ResetStats();
+
+private:
+  void SleepUntil(MonotonicTime::time_point target);
+
+private:
+  MonotonicTime::duration   period;
+  MonotonicTime::time_point deadline;
+  Stats                     stats;
+  Float64                   sleepMean;
+  Float64                   sleepM2;
+  Uint64                    sleepSamples;
+};
+
+}  // namespace NycaTech
+
+#endif  // FRAME_PACER_H
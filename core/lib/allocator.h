@@ -0,0 +1,37 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <new>
+
+#include "types.h"
+
+namespace NycaTech {
+
+#ifndef INLINE_LIB
+#define INLINE_LIB inline
+#endif
+
+// Allocators hand containers raw, aligned memory through Allocate and Deallocate. A container keeps its allocator by
+// value and passes it along when it is moved or copied, so stateful allocators must stay cheap to copy.
+struct HeapAllocator {
+  INLINE_LIB void* Allocate(Uint64 bytes, Uint64 alignment);
+  INLINE_LIB void  Deallocate(void* memory, Uint64 bytes, Uint64 alignment);
+};
+
+INLINE_LIB void* HeapAllocator::Allocate(const Uint64 bytes, const Uint64 alignment)
+{
+  return ::operator new(bytes, std::align_val_t(alignment));
+}
+
+INLINE_LIB void HeapAllocator::Deallocate(void* memory, Uint64, const Uint64 alignment)
+{
+  ::operator delete(memory, std::align_val_t(alignment));
+}
+
+}  // namespace NycaTech
+
+#endif  // ALLOCATOR_H
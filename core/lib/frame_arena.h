@@ -0,0 +1,72 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include "linear_arena.h"
+#include "types.h"
+#include "vector.h"
+
+namespace NycaTech {
+
+#ifndef INLINE_LIB
+#define INLINE_LIB inline
+#endif
+
+// Scratch memory that lives until the end of the current frame. Every thread bumps its own LinearArena, so an
+// allocation is a pointer increment with no locking. NextFrame ends the frame for all threads at once: each arena
+// resets the next time its thread touches it. Call it only where no thread still holds frame memory, such as the end
+// of a frame in World::Run, and from a single loop per process.
+class FrameArena final {
+public:
+  INLINE_LIB static LinearArena& Local();
+  INLINE_LIB static void         NextFrame();
+  INLINE_LIB static Uint64       Frame();
+
+private:
+  struct ThreadArena {
+    LinearArena arena;
+    Uint64      frame = 0;
+  };
+
+  inline static Atomic<Uint64> frame = 0;
+};
+
+// Allocator for containers that only live within a frame, e.g. FrameVector<T>.
+struct FrameAllocator {
+  void* Allocate(Uint64 bytes, Uint64 alignment) { return FrameArena::Local().Allocate(bytes, alignment); }
+  void  Deallocate(void* memory, Uint64 bytes, Uint64 alignment)
+  {
+    FrameArena::Local().Deallocate(memory, bytes, alignment);
+  }
+};
+
+template <typename T>
+using FrameVector = Vector<T, FrameAllocator>;
+
+INLINE_LIB LinearArena& FrameArena::Local()
+{
+  static thread_local ThreadArena local;
+  const Uint64                    current = frame.load(std::memory_order_acquire);
+  if (local.frame != current) {
+    local.arena.Reset();
+    local.frame = current;
+  }
+  return local.arena;
+}
+
+INLINE_LIB void FrameArena::NextFrame()
+{
+  frame.fetch_add(1, std::memory_order_release);
+}
+
+INLINE_LIB Uint64 FrameArena::Frame()
+{
+  return frame.load(std::memory_order_acquire);
+}
+
+}  // namespace NycaTech
+
+#endif  // FRAME_ARENA_H
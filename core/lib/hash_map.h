@@ -0,0 +1,583 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef HASH_MAP_H
+#define HASH_MAP_H
+
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define HASH_MAP_SSE2 1
+#endif
+
+#include "allocator.h"
+#include "pair.h"
+#include "types.h"
+
+namespace NycaTech {
+
+#ifndef INLINE_LIB
+#define INLINE_LIB inline
+#endif
+
+// Default hasher. Runs std::hash through a 64 bit finaliser, because the table takes its probe position and its
+// control byte from different bits and std::hash is the identity for integers. Anything convertible to a string_view
+// hashes as one, so String keys can be looked up by `const char*` without building a String.
+struct Hash {
+  using is_transparent = void;
+
+  template <typename Q>
+  INLINE_LIB Uint64 operator()(const Q& key) const;
+};
+
+template <typename Q>
+Uint64 Hash::operator()(const Q& key) const
+{
+  Uint64 hash;
+  if constexpr (std::is_convertible_v<const Q&, std::string_view>) {
+    hash = std::hash<std::string_view>{}(std::string_view(key));
+  }
+  else {
+    hash = std::hash<Q>{}(key);
+  }
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCDull;
+  hash ^= hash >> 33;
+  hash *= 0xC4CEB9FE1A85EC53ull;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+// Open-addressing hash table in the SwissTable layout: one control byte per slot holds either 7 bits of the key's
+// hash or an empty/deleted marker, and lookups compare a whole group of 16 control bytes at once (SSE2, or a scalar
+// loop elsewhere) before touching any key. Entries live inline in a single array, so growing or erasing invalidates
+// pointers into the map. Lookups take any key type the hasher and Equal accept.
+template <typename K, typename V, typename Hasher = Hash, typename Equal = std::equal_to<>,
+          typename Allocator = HeapAllocator>
+class HashMap {
+public:
+  using Entry = Pair<K, V>;
+
+  template <bool IsConst>
+  class Iterator {
+  public:
+    using Map = std::conditional_t<IsConst, const HashMap, HashMap>;
+    using Reference = std::conditional_t<IsConst, const Entry&, Entry&>;
+    using Pointer = std::conditional_t<IsConst, const Entry*, Entry*>;
+
+    INLINE_LIB Iterator(Map* map, Uint64 index);
+
+    INLINE_LIB Reference operator*() const;
+    INLINE_LIB Pointer   operator->() const;
+    INLINE_LIB Iterator& operator++();
+    INLINE_LIB bool      operator==(const Iterator& other) const;
+    INLINE_LIB bool      operator!=(const Iterator& other) const;
+
+  private:
+    INLINE_LIB void SkipFree();
+
+    Map*   map;
+    Uint64 index;
+  };
+
+  INLINE_LIB HashMap() = default;
+  INLINE_LIB explicit HashMap(const Allocator& allocator);
+  INLINE_LIB HashMap(HashMap&& other) noexcept;
+  INLINE_LIB HashMap(const HashMap& other);
+  INLINE_LIB ~HashMap();
+
+  INLINE_LIB HashMap& operator=(HashMap&& other) noexcept;
+  INLINE_LIB HashMap& operator=(const HashMap& other);
+
+public:
+  template <typename Q>
+  INLINE_LIB V* Find(const Q& key);
+  template <typename Q>
+  INLINE_LIB const V* Find(const Q& key) const;
+  template <typename Q>
+  INLINE_LIB bool Contains(const Q& key) const;
+  template <typename Q>
+  INLINE_LIB bool Erase(const Q& key);
+
+  // Inserts key with a V built from args unless it is already present; either way returns its value and whether it
+  // was inserted.
+  template <typename Q, typename... Args>
+  INLINE_LIB Pair<V*, bool> TryEmplace(const Q& key, Args&&... args);
+  template <typename Q>
+  INLINE_LIB V& operator[](const Q& key);
+
+  INLINE_LIB void   Reserve(Uint32 count);
+  INLINE_LIB void   Clear();
+  INLINE_LIB Uint32 Count() const;
+  INLINE_LIB bool   IsEmpty() const;
+  INLINE_LIB Uint64 Capacity() const;
+
+public:
+  INLINE_LIB Iterator<false> begin();
+  INLINE_LIB Iterator<true>  begin() const;
+  INLINE_LIB Iterator<false> end();
+  INLINE_LIB Iterator<true>  end() const;
+
+  static constexpr Uint32 GroupWidth = 16;
+
+private:
+  static constexpr Int8 Empty = -128;
+  static constexpr Int8 Deleted = -2;
+
+  // Bit i of every mask is set when control byte i of the group matches.
+  struct Group {
+    INLINE_LIB explicit Group(const Int8* control);
+
+    INLINE_LIB Uint32 Match(Int8 hash) const;
+    INLINE_LIB Uint32 MatchEmpty() const;
+    INLINE_LIB Uint32 MatchFree() const;
+
+#ifdef HASH_MAP_SSE2
+    __m128i bytes;
+#else
+    Int8 bytes[GroupWidth];
+#endif
+  };
+
+  template <typename Q>
+  INLINE_LIB Uint64 IndexOf(const Q& key, Uint64 hash) const;
+  INLINE_LIB Uint64 FreeSlot(Uint64 hash) const;
+  INLINE_LIB void   SetControl(Uint64 index, Int8 value);
+  INLINE_LIB void   Rehash(Uint64 newCapacity);
+  INLINE_LIB void   Release();
+
+  static constexpr Uint64 NotFound = UINT64_MAX;
+
+private:
+  Int8*                           control = nullptr;
+  Entry*                          entries = nullptr;
+  Uint64                          capacity = 0;
+  Uint32                          count = 0;
+  Uint32                          deleted = 0;
+  [[no_unique_address]] Hasher    hasher;
+  [[no_unique_address]] Equal     equal;
+  [[no_unique_address]] Allocator allocator;
+};
+
+#define HASH_MAP_TEMPLATE template <typename K, typename V, typename Hasher, typename Equal, typename Allocator>
+#define HASH_MAP HashMap<K, V, Hasher, Equal, Allocator>
+
+HASH_MAP_TEMPLATE
+HASH_MAP::Group::Group(const Int8* control)
+{
+#ifdef HASH_MAP_SSE2
+  bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control));
+#else
+  memcpy(bytes, control, GroupWidth);
+#endif
+}
+
+HASH_MAP_TEMPLATE
+Uint32 HASH_MAP::Group::Match(const Int8 hash) const
+{
+#ifdef HASH_MAP_SSE2
+  return static_cast<Uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(hash))));
+#else
+  Uint32 mask = 0;
+  for (Uint32 i = 0; i < GroupWidth; i++) {
+    mask |= static_cast<Uint32>(bytes[i] == hash) << i;
+  }
+  return mask;
+#endif
+}
+
+HASH_MAP_TEMPLATE
+Uint32 HASH_MAP::Group::MatchEmpty() const
+{
+  return Match(Empty);
+}
+
+// Empty and Deleted are the only control values with the sign bit set.
+HASH_MAP_TEMPLATE
+Uint32 HASH_MAP::Group::MatchFree() const
+{
+#ifdef HASH_MAP_SSE2
+  return static_cast<Uint32>(_mm_movemask_epi8(bytes));
+#else
+  Uint32 mask = 0;
+  for (Uint32 i = 0; i < GroupWidth; i++) {
+    mask |= static_cast<Uint32>(bytes[i] < 0) << i;
+  }
+  return mask;
+#endif
+}
+
+HASH_MAP_TEMPLATE
+HASH_MAP::HashMap(const Allocator& allocator)
+    : allocator(allocator)
+{
+}
+
+HASH_MAP_TEMPLATE
+HASH_MAP::HashMap(HashMap&& other) noexcept
+    : control(other.control),
+      entries(other.entries),
+      capacity(other.capacity),
+      count(other.count),
+      deleted(other.deleted),
+      hasher(std::move(other.hasher)),
+      equal(std::move(other.equal)),
+      allocator(std::move(other.allocator))
+{
+  other.control = nullptr;
+  other.entries = nullptr;
+  other.capacity = 0;
+  other.count = 0;
+  other.deleted = 0;
+}
+
+HASH_MAP_TEMPLATE
+HASH_MAP::HashMap(const HashMap& other)
+    : hasher(other.hasher), equal(other.equal), allocator(other.allocator)
+{
+  Self = other;
+}
+
+HASH_MAP_TEMPLATE
+HASH_MAP::~HashMap()
+{
+  Release();
+}
+
+HASH_MAP_TEMPLATE
+HASH_MAP& HASH_MAP::operator=(HashMap&& other) noexcept
+{
+  if (this != &other) {
+    Release();
+    control = other.control;
+    entries = other.entries;
+    capacity = other.capacity;
+    count = other.count;
+    deleted = other.deleted;
+    hasher = std::move(other.hasher);
+    equal = std::move(other.equal);
+    allocator = std::move(other.allocator);
+    other.control = nullptr;
+    other.entries = nullptr;
+    other.capacity = 0;
+    other.count = 0;
+    other.deleted = 0;
+  }
+  return Self;
+}
+
+HASH_MAP_TEMPLATE
+HASH_MAP& HASH_MAP::operator=(const HashMap& other)
+{
+  if (this != &other) {
+    Clear();
+    Reserve(other.count);
+    for (const Entry& entry : other) {
+      TryEmplace(entry.first, entry.second);
+    }
+  }
+  return Self;
+}
+
+HASH_MAP_TEMPLATE
+template <typename Q>
+V* HASH_MAP::Find(const Q& key)
+{
+  const Uint64 index = IndexOf(key, hasher(key));
+  return index == NotFound ? nullptr : &entries[index].second;
+}
+
+HASH_MAP_TEMPLATE
+template <typename Q>
+const V* HASH_MAP::Find(const Q& key) const
+{
+  const Uint64 index = IndexOf(key, hasher(key));
+  return index == NotFound ? nullptr : &entries[index].second;
+}
+
+HASH_MAP_TEMPLATE
+template <typename Q>
+bool HASH_MAP::Contains(const Q& key) const
+{
+  return IndexOf(key, hasher(key)) != NotFound;
+}
+
+HASH_MAP_TEMPLATE
+template <typename Q>
+bool HASH_MAP::Erase(const Q& key)
+{
+  const Uint64 index = IndexOf(key, hasher(key));
+  if (index == NotFound) {
+    return false;
+  }
+  entries[index].~Entry();
+  // Probes only stop at empty bytes. If the empties around the slot are less than a group apart, no probe window ever
+  // saw this slot's neighbourhood full, so no probe went past it and the slot can become empty again.
+  const Uint32 emptyAfter = Group(control + index).MatchEmpty();
+  const Uint32 emptyBefore = Group(control + ((index - GroupWidth) & (capacity - 1))).MatchEmpty();
+  const bool   wasNeverFull = emptyAfter && emptyBefore
+                            && std::countr_zero(emptyAfter) + std::countl_zero(static_cast<Uint16>(emptyBefore))
+                                   < static_cast<int>(GroupWidth);
+  SetControl(index, wasNeverFull ? Empty : Deleted);
+  deleted += !wasNeverFull;
+  count--;
+  return true;
+}
+
+HASH_MAP_TEMPLATE
+template <typename Q, typename... Args>
+Pair<V*, bool> HASH_MAP::TryEmplace(const Q& key, Args&&... args)
+{
+  Uint64 hash = hasher(key);
+  Uint64 index = IndexOf(key, hash);
+  if (index != NotFound) {
+    return { &entries[index].second, false };
+  }
+
+  // Keep at least one empty byte in every probe sequence by never filling past 7/8, counting tombstones.
+  if (static_cast<Uint64>(count + deleted + 1) * 8 > capacity * 7) {
+    Rehash(capacity == 0 ? GroupWidth : static_cast<Uint64>(count + 1) * 16 > capacity * 7 ? capacity * 2 : capacity);
+  }
+  index = FreeSlot(hash);
+  deleted -= control[index] == Deleted;
+  new (entries + index) Entry{ K(key), V(std::forward<Args>(args)...) };
+  SetControl(index, static_cast<Int8>(hash & 0x7F));
+  count++;
+  return { &entries[index].second, true };
+}
+
+HASH_MAP_TEMPLATE
+template <typename Q>
+V& HASH_MAP::operator[](const Q& key)
+{
+  return *TryEmplace(key).first;
+}
+
+HASH_MAP_TEMPLATE
+void HASH_MAP::Reserve(const Uint32 newCount)
+{
+  Uint64 needed = GroupWidth;
+  while (needed * 7 < static_cast<Uint64>(newCount) * 8) {
+    needed *= 2;
+  }
+  if (needed > capacity) {
+    Rehash(needed);
+  }
+}
+
+HASH_MAP_TEMPLATE
+void HASH_MAP::Clear()
+{
+  if constexpr (!std::is_trivially_destructible_v<Entry>) {
+    for (Entry& entry : Self) {
+      entry.~Entry();
+    }
+  }
+  if (control) {
+    memset(control, Empty, capacity + GroupWidth);
+  }
+  count = 0;
+  deleted = 0;
+}
+
+HASH_MAP_TEMPLATE
+Uint32 HASH_MAP::Count() const
+{
+  return count;
+}
+
+HASH_MAP_TEMPLATE
+bool HASH_MAP::IsEmpty() const
+{
+  return count == 0;
+}
+
+HASH_MAP_TEMPLATE
+Uint64 HASH_MAP::Capacity() const
+{
+  return capacity;
+}
+
+HASH_MAP_TEMPLATE
+typename HASH_MAP::template Iterator<false> HASH_MAP::begin()
+{
+  return Iterator<false>(this, 0);
+}
+
+HASH_MAP_TEMPLATE
+typename HASH_MAP::template Iterator<true> HASH_MAP::begin() const
+{
+  return Iterator<true>(this, 0);
+}
+
+HASH_MAP_TEMPLATE
+typename HASH_MAP::template Iterator<false> HASH_MAP::end()
+{
+  return Iterator<false>(this, capacity);
+}
+
+HASH_MAP_TEMPLATE
+typename HASH_MAP::template Iterator<true> HASH_MAP::end() const
+{
+  return Iterator<true>(this, capacity);
+}
+
+// Probes groups triangularly from the hash's home slot. Every group is visited once per power-of-two capacity, and a
+// group holding an empty byte ends the probe because an insert would have stopped there.
+HASH_MAP_TEMPLATE
+template <typename Q>
+Uint64 HASH_MAP::IndexOf(const Q& key, const Uint64 hash) const
+{
+  if (count == 0) {
+    return NotFound;
+  }
+  const Uint64 mask = capacity - 1;
+  const Int8   tag = static_cast<Int8>(hash & 0x7F);
+  Uint64       position = (hash >> 7) & mask;
+  for (Uint64 step = GroupWidth;; step += GroupWidth) {
+    const Group group(control + position);
+    for (Uint32 match = group.Match(tag); match; match &= match - 1) {
+      const Uint64 index = (position + std::countr_zero(match)) & mask;
+      if (equal(entries[index].first, key)) {
+        return index;
+      }
+    }
+    if (group.MatchEmpty()) {
+      return NotFound;
+    }
+    position = (position + step) & mask;
+  }
+}
+
+HASH_MAP_TEMPLATE
+Uint64 HASH_MAP::FreeSlot(const Uint64 hash) const
+{
+  const Uint64 mask = capacity - 1;
+  Uint64       position = (hash >> 7) & mask;
+  for (Uint64 step = GroupWidth;; step += GroupWidth) {
+    if (const Uint32 free = Group(control + position).MatchFree()) {
+      return (position + std::countr_zero(free)) & mask;
+    }
+    position = (position + step) & mask;
+  }
+}
+
+// The first GroupWidth control bytes are mirrored past the end, so a group loaded near the end wraps around.
+HASH_MAP_TEMPLATE
+void HASH_MAP::SetControl(const Uint64 index, const Int8 value)
+{
+  control[index] = value;
+  if (index < GroupWidth) {
+    control[capacity + index] = value;
+  }
+}
+
+HASH_MAP_TEMPLATE
+void HASH_MAP::Rehash(const Uint64 newCapacity)
+{
+  Int8*        oldControl = control;
+  Entry*       oldEntries = entries;
+  const Uint64 oldCapacity = capacity;
+
+  capacity = newCapacity;
+  control = static_cast<Int8*>(allocator.Allocate(capacity + GroupWidth, GroupWidth));
+  entries = static_cast<Entry*>(allocator.Allocate(sizeof(Entry) * capacity, alignof(Entry)));
+  memset(control, Empty, capacity + GroupWidth);
+  deleted = 0;
+
+  for (Uint64 i = 0; i < oldCapacity; i++) {
+    if (oldControl[i] >= 0) {
+      const Uint64 hash = hasher(oldEntries[i].first);
+      const Uint64 index = FreeSlot(hash);
+      new (entries + index) Entry(std::move(oldEntries[i]));
+      oldEntries[i].~Entry();
+      SetControl(index, static_cast<Int8>(hash & 0x7F));
+    }
+  }
+  if (oldControl) {
+    allocator.Deallocate(oldControl, oldCapacity + GroupWidth, GroupWidth);
+    allocator.Deallocate(oldEntries, sizeof(Entry) * oldCapacity, alignof(Entry));
+  }
+}
+
+HASH_MAP_TEMPLATE
+void HASH_MAP::Release()
+{
+  Clear();
+  if (control) {
+    allocator.Deallocate(control, capacity + GroupWidth, GroupWidth);
+    allocator.Deallocate(entries, sizeof(Entry) * capacity, alignof(Entry));
+  }
+  control = nullptr;
+  entries = nullptr;
+  capacity = 0;
+}
+
+HASH_MAP_TEMPLATE
+template <bool IsConst>
+HASH_MAP::Iterator<IsConst>::Iterator(Map* map, const Uint64 index)
+    : map(map), index(index)
+{
+  SkipFree();
+}
+
+HASH_MAP_TEMPLATE
+template <bool IsConst>
+typename HASH_MAP::template Iterator<IsConst>::Reference HASH_MAP::Iterator<IsConst>::operator*() const
+{
+  return map->entries[index];
+}
+
+HASH_MAP_TEMPLATE
+template <bool IsConst>
+typename HASH_MAP::template Iterator<IsConst>::Pointer HASH_MAP::Iterator<IsConst>::operator->() const
+{
+  return &map->entries[index];
+}
+
+HASH_MAP_TEMPLATE
+template <bool IsConst>
+typename HASH_MAP::template Iterator<IsConst>& HASH_MAP::Iterator<IsConst>::operator++()
+{
+  index++;
+  SkipFree();
+  return Self;
+}
+
+HASH_MAP_TEMPLATE
+template <bool IsConst>
+bool HASH_MAP::Iterator<IsConst>::operator==(const Iterator& other) const
+{
+  return index == other.index;
+}
+
+HASH_MAP_TEMPLATE
+template <bool IsConst>
+bool HASH_MAP::Iterator<IsConst>::operator!=(const Iterator& other) const
+{
+  return index != other.index;
+}
+
+HASH_MAP_TEMPLATE
+template <bool IsConst>
+void HASH_MAP::Iterator<IsConst>::SkipFree()
+{
+  while (index < map->capacity && map->control[index] < 0) {
+    index++;
+  }
+}
+
+#undef HASH_MAP
+#undef HASH_MAP_TEMPLATE
+
+}  // namespace NycaTech
+
+#endif  // HASH_MAP_H
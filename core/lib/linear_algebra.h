@@ -0,0 +1,667 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef LINEAR_ALGEBRA_H
+#define LINEAR_ALGEBRA_H
+
+#include <cmath>
+#include <cstring>
+
+#include "types.h"
+
+#if defined(__AVX2__)
+#define NYCA_MATH_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NYCA_MATH_SSE 1
+#endif
+
+#if defined(NYCA_MATH_AVX2)
+#include <immintrin.h>
+#elif defined(NYCA_MATH_SSE)
+#include <emmintrin.h>
+#endif
+
+namespace NycaTech::Math {
+
+#ifndef INLINE_LIB
+#define INLINE_LIB inline
+#endif
+
+// Vectors and matrices the renderer and the ECS compute with. Vect3, Quad and Transform stay the storage types;
+// these convert from and to them. Mat4 is column-major with columns 16-byte aligned, the layout GLSL and Vulkan
+// expect, so it can be copied into uniform buffers as is. Quaternions are stored x, y, z, w.
+//
+// Vec4, Quat and Mat4 operations use SSE when the target has it. The batch functions at the bottom process AVX2, SSE
+// or scalar lanes of objects at a time, whichever is the widest the compiler was told it may use.
+
+struct Vec3 {
+  float x;
+  float y;
+  float z;
+};
+
+struct alignas(16) Vec4 {
+  float x;
+  float y;
+  float z;
+  float w;
+};
+
+struct alignas(16) Quat {
+  float x;
+  float y;
+  float z;
+  float w;
+};
+
+struct alignas(16) Mat4 {
+  float m[16];
+
+  float*       Column(Uint32 column) { return m + column * 4; }
+  const float* Column(Uint32 column) const { return m + column * 4; }
+  float&       operator()(Uint32 row, Uint32 column) { return m[column * 4 + row]; }
+  float        operator()(Uint32 row, Uint32 column) const { return m[column * 4 + row]; }
+};
+
+static_assert(sizeof(Vec3) == 12 && sizeof(Vec4) == 16 && sizeof(Quat) == 16 && sizeof(Mat4) == 64);
+static_assert(sizeof(Transform) == 10 * sizeof(float), "batch kernels read Transform as ten packed floats");
+
+constexpr float Pi = 3.14159265358979323846f;
+
+// Vec3. Three floats do not fill a register, so these stay scalar and let the compiler vectorize loops over them.
+
+INLINE_LIB Vec3 ToVec3(const Vect3& v) { return { v[0], v[1], v[2] }; }
+INLINE_LIB Vect3 ToVect3(const Vec3& v) { return { v.x, v.y, v.z }; }
+
+INLINE_LIB Vec3 operator+(const Vec3& lhs, const Vec3& rhs) { return { lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z }; }
+INLINE_LIB Vec3 operator-(const Vec3& lhs, const Vec3& rhs) { return { lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z }; }
+INLINE_LIB Vec3 operator*(const Vec3& lhs, const Vec3& rhs) { return { lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z }; }
+INLINE_LIB Vec3 operator*(const Vec3& v, float s) { return { v.x * s, v.y * s, v.z * s }; }
+INLINE_LIB Vec3 operator-(const Vec3& v) { return { -v.x, -v.y, -v.z }; }
+
+INLINE_LIB float Dot(const Vec3& lhs, const Vec3& rhs) { return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z; }
+
+INLINE_LIB Vec3 Cross(const Vec3& lhs, const Vec3& rhs)
+{
+  return { lhs.y * rhs.z - lhs.z * rhs.y, lhs.z * rhs.x - lhs.x * rhs.z, lhs.x * rhs.y - lhs.y * rhs.x };
+}
+
+INLINE_LIB float Length(const Vec3& v) { return std::sqrt(Dot(v, v)); }
+
+INLINE_LIB Vec3 Normalize(const Vec3& v)
+{
+  const float length = Length(v);
+  return length > 0.0f ? v * (1.0f / length) : v;
+}
+
+// Vec4.
+
+#if defined(NYCA_MATH_SSE)
+INLINE_LIB __m128 Load(const Vec4& v) { return _mm_load_ps(&v.x); }
+INLINE_LIB Vec4 Store(__m128 r)
+{
+  Vec4 v;
+  _mm_store_ps(&v.x, r);
+  return v;
+}
+#endif
+
+INLINE_LIB Vec4 ToVec4(const Vec3& v, float w) { return { v.x, v.y, v.z, w }; }
+INLINE_LIB Vec3 ToVec3(const Vec4& v) { return { v.x, v.y, v.z }; }
+
+INLINE_LIB Vec4 operator+(const Vec4& lhs, const Vec4& rhs)
+{
+#if defined(NYCA_MATH_SSE)
+  return Store(_mm_add_ps(Load(lhs), Load(rhs)));
+#else
+  return { lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z, lhs.w + rhs.w };
+#endif
+}
+
+INLINE_LIB Vec4 operator-(const Vec4& lhs, const Vec4& rhs)
+{
+#if defined(NYCA_MATH_SSE)
+  return Store(_mm_sub_ps(Load(lhs), Load(rhs)));
+#else
+  return { lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z, lhs.w - rhs.w };
+#endif
+}
+
+INLINE_LIB Vec4 operator*(const Vec4& lhs, const Vec4& rhs)
+{
+#if defined(NYCA_MATH_SSE)
+  return Store(_mm_mul_ps(Load(lhs), Load(rhs)));
+#else
+  return { lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z, lhs.w * rhs.w };
+#endif
+}
+
+INLINE_LIB Vec4 operator*(const Vec4& v, float s)
+{
+#if defined(NYCA_MATH_SSE)
+  return Store(_mm_mul_ps(Load(v), _mm_set1_ps(s)));
+#else
+  return { v.x * s, v.y * s, v.z * s, v.w * s };
+#endif
+}
+
+INLINE_LIB float Dot(const Vec4& lhs, const Vec4& rhs)
+{
+#if defined(NYCA_MATH_SSE)
+  __m128 r = _mm_mul_ps(Load(lhs), Load(rhs));
+  r = _mm_add_ps(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 3, 0, 1)));
+  r = _mm_add_ps(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 0, 3, 2)));
+  return _mm_cvtss_f32(r);
+#else
+  return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z + lhs.w * rhs.w;
+#endif
+}
+
+INLINE_LIB float Length(const Vec4& v) { return std::sqrt(Dot(v, v)); }
+
+INLINE_LIB Vec4 Normalize(const Vec4& v)
+{
+  const float length = Length(v);
+  return length > 0.0f ? v * (1.0f / length) : v;
+}
+
+// Quat.
+
+INLINE_LIB Quat ToQuat(const Quad& q) { return { q[0], q[1], q[2], q[3] }; }
+INLINE_LIB Quad ToQuad(const Quat& q) { return { q.x, q.y, q.z, q.w }; }
+
+INLINE_LIB Quat Identity() { return { 0.0f, 0.0f, 0.0f, 1.0f }; }
+
+// Rotation of `radians` around `axis`, which must be unit length.
+INLINE_LIB Quat FromAxisAngle(const Vec3& axis, float radians)
+{
+  const float s = std::sin(radians * 0.5f);
+  return { axis.x * s, axis.y * s, axis.z * s, std::cos(radians * 0.5f) };
+}
+
+// Hamilton product: rotating by the result rotates by rhs first, then lhs.
+INLINE_LIB Quat operator*(const Quat& lhs, const Quat& rhs)
+{
+#if defined(NYCA_MATH_SSE)
+  const __m128 b = _mm_load_ps(&rhs.x);
+  __m128       r = _mm_mul_ps(_mm_set1_ps(lhs.w), b);
+  r = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(lhs.x), _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3))),
+                               _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f)));
+  r = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(lhs.y), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))),
+                               _mm_setr_ps(1.0f, 1.0f, -1.0f, -1.0f)));
+  r = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(lhs.z), _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1))),
+                               _mm_setr_ps(-1.0f, 1.0f, 1.0f, -1.0f)));
+  Quat q;
+  _mm_store_ps(&q.x, r);
+  return q;
+#else
+  return { lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y,
+           lhs.w * rhs.y - lhs.x * rhs.z + lhs.y * rhs.w + lhs.z * rhs.x,
+           lhs.w * rhs.z + lhs.x * rhs.y - lhs.y * rhs.x + lhs.z * rhs.w,
+           lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z };
+#endif
+}
+
+// Yaw turns around +Y, pitch around +X and roll around +Z; roll is applied first and yaw last.
+INLINE_LIB Quat FromEuler(float yaw, float pitch, float roll)
+{
+  return FromAxisAngle({ 0.0f, 1.0f, 0.0f }, yaw) * FromAxisAngle({ 1.0f, 0.0f, 0.0f }, pitch)
+         * FromAxisAngle({ 0.0f, 0.0f, 1.0f }, roll);
+}
+
+INLINE_LIB Quat Conjugate(const Quat& q) { return { -q.x, -q.y, -q.z, q.w }; }
+
+INLINE_LIB Quat Normalize(const Quat& q)
+{
+  const Vec4 v = Normalize(Vec4{ q.x, q.y, q.z, q.w });
+  return { v.x, v.y, v.z, v.w };
+}
+
+INLINE_LIB Vec3 Rotate(const Quat& q, const Vec3& v)
+{
+  const Vec3 axis{ q.x, q.y, q.z };
+  const Vec3 t = Cross(axis, v) * 2.0f;
+  return v + t * q.w + Cross(axis, t);
+}
+
+// Mat4.
+
+INLINE_LIB Mat4 IdentityMatrix()
+{
+  return { { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f } };
+}
+
+INLINE_LIB Mat4 operator*(const Mat4& lhs, const Mat4& rhs)
+{
+  Mat4 result;
+#if defined(NYCA_MATH_SSE)
+  const __m128 c0 = _mm_load_ps(lhs.m);
+  const __m128 c1 = _mm_load_ps(lhs.m + 4);
+  const __m128 c2 = _mm_load_ps(lhs.m + 8);
+  const __m128 c3 = _mm_load_ps(lhs.m + 12);
+  for (Uint32 column = 0; column < 4; column++) {
+    const float* r = rhs.Column(column);
+    __m128       sum = _mm_mul_ps(c0, _mm_set1_ps(r[0]));
+    sum = _mm_add_ps(sum, _mm_mul_ps(c1, _mm_set1_ps(r[1])));
+    sum = _mm_add_ps(sum, _mm_mul_ps(c2, _mm_set1_ps(r[2])));
+    sum = _mm_add_ps(sum, _mm_mul_ps(c3, _mm_set1_ps(r[3])));
+    _mm_store_ps(result.Column(column), sum);
+  }
+#else
+  for (Uint32 column = 0; column < 4; column++) {
+    for (Uint32 row = 0; row < 4; row++) {
+      result(row, column) = lhs(row, 0) * rhs(0, column) + lhs(row, 1) * rhs(1, column) + lhs(row, 2) * rhs(2, column)
+                            + lhs(row, 3) * rhs(3, column);
+    }
+  }
+#endif
+  return result;
+}
+
+INLINE_LIB Vec4 operator*(const Mat4& m, const Vec4& v)
+{
+#if defined(NYCA_MATH_SSE)
+  __m128 sum = _mm_mul_ps(_mm_load_ps(m.m), _mm_set1_ps(v.x));
+  sum = _mm_add_ps(sum, _mm_mul_ps(_mm_load_ps(m.m + 4), _mm_set1_ps(v.y)));
+  sum = _mm_add_ps(sum, _mm_mul_ps(_mm_load_ps(m.m + 8), _mm_set1_ps(v.z)));
+  sum = _mm_add_ps(sum, _mm_mul_ps(_mm_load_ps(m.m + 12), _mm_set1_ps(v.w)));
+  return Store(sum);
+#else
+  Vec4 result;
+  float* out = &result.x;
+  for (Uint32 row = 0; row < 4; row++) {
+    out[row] = m(row, 0) * v.x + m(row, 1) * v.y + m(row, 2) * v.z + m(row, 3) * v.w;
+  }
+  return result;
+#endif
+}
+
+INLINE_LIB Mat4 Transpose(const Mat4& m)
+{
+  Mat4 result;
+#if defined(NYCA_MATH_SSE)
+  __m128 c0 = _mm_load_ps(m.m);
+  __m128 c1 = _mm_load_ps(m.m + 4);
+  __m128 c2 = _mm_load_ps(m.m + 8);
+  __m128 c3 = _mm_load_ps(m.m + 12);
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+  _mm_store_ps(result.m, c0);
+  _mm_store_ps(result.m + 4, c1);
+  _mm_store_ps(result.m + 8, c2);
+  _mm_store_ps(result.m + 12, c3);
+#else
+  for (Uint32 column = 0; column < 4; column++) {
+    for (Uint32 row = 0; row < 4; row++) {
+      result(row, column) = m(column, row);
+    }
+  }
+#endif
+  return result;
+}
+
+INLINE_LIB Vec3 TransformPoint(const Mat4& m, const Vec3& p) { return ToVec3(m * ToVec4(p, 1.0f)); }
+INLINE_LIB Vec3 TransformVector(const Mat4& m, const Vec3& v) { return ToVec3(m * ToVec4(v, 0.0f)); }
+
+INLINE_LIB Mat4 Translation(const Vec3& offset)
+{
+  Mat4 result = IdentityMatrix();
+  result(0, 3) = offset.x;
+  result(1, 3) = offset.y;
+  result(2, 3) = offset.z;
+  return result;
+}
+
+INLINE_LIB Mat4 Scaling(const Vec3& scale)
+{
+  Mat4 result = IdentityMatrix();
+  result(0, 0) = scale.x;
+  result(1, 1) = scale.y;
+  result(2, 2) = scale.z;
+  return result;
+}
+
+// Translation * Rotation * Scale: scales first, then rotates, then moves. `rotation` must be unit length.
+INLINE_LIB Mat4 Compose(const Vec3& position, const Quat& rotation, const Vec3& scale)
+{
+  const float x = rotation.x, y = rotation.y, z = rotation.z, w = rotation.w;
+  const float xx = x * x, yy = y * y, zz = z * z;
+  const float xy = x * y, xz = x * z, yz = y * z;
+  const float wx = w * x, wy = w * y, wz = w * z;
+  return { { (1.0f - 2.0f * (yy + zz)) * scale.x, 2.0f * (xy + wz) * scale.x, 2.0f * (xz - wy) * scale.x, 0.0f,
+             2.0f * (xy - wz) * scale.y, (1.0f - 2.0f * (xx + zz)) * scale.y, 2.0f * (yz + wx) * scale.y, 0.0f,
+             2.0f * (xz + wy) * scale.z, 2.0f * (yz - wx) * scale.z, (1.0f - 2.0f * (xx + yy)) * scale.z, 0.0f,
+             position.x, position.y, position.z, 1.0f } };
+}
+
+INLINE_LIB Mat4 Rotation(const Quat& rotation) { return Compose({ 0.0f, 0.0f, 0.0f }, rotation, { 1.0f, 1.0f, 1.0f }); }
+
+INLINE_LIB Mat4 Compose(const Transform& transform)
+{
+  return Compose(ToVec3(transform.position), ToQuat(transform.rotation), ToVec3(transform.scale));
+}
+
+// Inverse of a matrix whose bottom row is 0 0 0 1, such as anything Compose returns. Cheaper and better conditioned
+// than a general 4x4 inverse. A singular upper 3x3 yields the identity.
+INLINE_LIB Mat4 InverseAffine(const Mat4& m)
+{
+  const Vec3  a{ m(0, 0), m(1, 0), m(2, 0) };
+  const Vec3  b{ m(0, 1), m(1, 1), m(2, 1) };
+  const Vec3  c{ m(0, 2), m(1, 2), m(2, 2) };
+  const Vec3  bc = Cross(b, c);
+  const float determinant = Dot(a, bc);
+  if (determinant == 0.0f) {
+    return IdentityMatrix();
+  }
+
+  // Rows of the inverse are the cross products of the columns, scaled by the inverse determinant.
+  const float inverse = 1.0f / determinant;
+  const Vec3  r0 = bc * inverse;
+  const Vec3  r1 = Cross(c, a) * inverse;
+  const Vec3  r2 = Cross(a, b) * inverse;
+  const Vec3  t{ m(0, 3), m(1, 3), m(2, 3) };
+  return { { r0.x, r1.x, r2.x, 0.0f, r0.y, r1.y, r2.y, 0.0f, r0.z, r1.z, r2.z, 0.0f, -Dot(r0, t), -Dot(r1, t),
+             -Dot(r2, t), 1.0f } };
+}
+
+// Right-handed view matrix looking from `eye` toward `target`.
+INLINE_LIB Mat4 LookAt(const Vec3& eye, const Vec3& target, const Vec3& up)
+{
+  const Vec3 f = Normalize(target - eye);
+  const Vec3 s = Normalize(Cross(f, up));
+  const Vec3 u = Cross(s, f);
+  return { { s.x, u.x, -f.x, 0.0f, s.y, u.y, -f.y, 0.0f, s.z, u.z, -f.z, 0.0f, -Dot(s, eye), -Dot(u, eye), Dot(f, eye),
+             1.0f } };
+}
+
+// Right-handed projection for Vulkan clip space: depth maps to [0, 1] and Y points down.
+INLINE_LIB Mat4 Perspective(float fovY, float aspect, float nearPlane, float farPlane)
+{
+  const float f = 1.0f / std::tan(fovY * 0.5f);
+  Mat4        result{};
+  result(0, 0) = f / aspect;
+  result(1, 1) = -f;
+  result(2, 2) = farPlane / (nearPlane - farPlane);
+  result(3, 2) = -1.0f;
+  result(2, 3) = nearPlane * farPlane / (nearPlane - farPlane);
+  return result;
+}
+
+// Batches. Each kernel is written once against a lane type: one float, four SSE floats or eight AVX2 floats. Lanes
+// hold the same field of consecutive objects, so one instruction advances a whole group of objects. Wide picks the
+// widest lane type available and the scalar lane finishes the remainder.
+
+namespace Lanes {
+
+struct Float1 {
+  static constexpr Uint32 Width = 1;
+
+  float v;
+
+  Float1(float s)
+      : v(s)
+  {
+  }
+
+  static Float1 Gather(const float* base, Uint32) { return *base; }
+  void          Scatter(float* base, Uint32) const { *base = v; }
+
+  static void Deinterleave(const float* in, Float1& x, Float1& y, Float1& z)
+  {
+    x = in[0];
+    y = in[1];
+    z = in[2];
+  }
+
+  static void Interleave(Float1 x, Float1 y, Float1 z, float* out)
+  {
+    out[0] = x.v;
+    out[1] = y.v;
+    out[2] = z.v;
+  }
+};
+
+INLINE_LIB Float1 operator+(Float1 lhs, Float1 rhs) { return lhs.v + rhs.v; }
+INLINE_LIB Float1 operator-(Float1 lhs, Float1 rhs) { return lhs.v - rhs.v; }
+INLINE_LIB Float1 operator*(Float1 lhs, Float1 rhs) { return lhs.v * rhs.v; }
+
+#if defined(NYCA_MATH_SSE)
+struct Float4 {
+  static constexpr Uint32 Width = 4;
+
+  __m128 v;
+
+  Float4(__m128 r)
+      : v(r)
+  {
+  }
+  Float4(float s)
+      : v(_mm_set1_ps(s))
+  {
+  }
+
+  static Float4 Gather(const float* base, Uint32 stride)
+  {
+    return _mm_setr_ps(base[0], base[stride], base[2 * stride], base[3 * stride]);
+  }
+
+  void Scatter(float* base, Uint32 stride) const
+  {
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, v);
+    for (Uint32 i = 0; i < 4; i++) {
+      base[i * stride] = lanes[i];
+    }
+  }
+
+  // Splits four packed xyz triples into x, y and z lanes with three loads and five shuffles, where Gather would
+  // assemble each lane from scalar loads.
+  static void Deinterleave(const float* in, Float4& x, Float4& y, Float4& z)
+  {
+    const __m128 a = _mm_loadu_ps(in);      // x0 y0 z0 x1
+    const __m128 b = _mm_loadu_ps(in + 4);  // y1 z1 x2 y2
+    const __m128 c = _mm_loadu_ps(in + 8);  // z2 x3 y3 z3
+    const __m128 xy = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));  // x2 y2 x3 y3
+    const __m128 yz = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));  // y0 z0 y1 z1
+    x = _mm_shuffle_ps(a, xy, _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+    z = _mm_shuffle_ps(yz, c, _MM_SHUFFLE(3, 0, 3, 1));
+  }
+
+  static void Interleave(Float4 x, Float4 y, Float4 z, float* out)
+  {
+    const __m128 xy01 = _mm_unpacklo_ps(x.v, y.v);                         // x0 y0 x1 y1
+    const __m128 xy23 = _mm_unpackhi_ps(x.v, y.v);                         // x2 y2 x3 y3
+    const __m128 zx = _mm_shuffle_ps(z.v, x.v, _MM_SHUFFLE(1, 1, 0, 0));    // z0 z0 x1 x1
+    const __m128 yz = _mm_shuffle_ps(xy01, z.v, _MM_SHUFFLE(1, 1, 3, 3));   // y1 y1 z1 z1
+    const __m128 zxy = _mm_shuffle_ps(z.v, xy23, _MM_SHUFFLE(3, 2, 3, 2));  // z2 z3 x3 y3
+    _mm_storeu_ps(out, _mm_shuffle_ps(xy01, zx, _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(out + 4, _mm_shuffle_ps(yz, xy23, _MM_SHUFFLE(1, 0, 2, 0)));
+    _mm_storeu_ps(out + 8, _mm_shuffle_ps(zxy, zxy, _MM_SHUFFLE(1, 3, 2, 0)));
+  }
+};
+
+INLINE_LIB Float4 operator+(Float4 lhs, Float4 rhs) { return _mm_add_ps(lhs.v, rhs.v); }
+INLINE_LIB Float4 operator-(Float4 lhs, Float4 rhs) { return _mm_sub_ps(lhs.v, rhs.v); }
+INLINE_LIB Float4 operator*(Float4 lhs, Float4 rhs) { return _mm_mul_ps(lhs.v, rhs.v); }
+#endif
+
+#if defined(NYCA_MATH_AVX2)
+struct Float8 {
+  static constexpr Uint32 Width = 8;
+
+  __m256 v;
+
+  Float8(__m256 r)
+      : v(r)
+  {
+  }
+  Float8(float s)
+      : v(_mm256_set1_ps(s))
+  {
+  }
+
+  static Float8 Gather(const float* base, Uint32 stride)
+  {
+    const __m256i offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                               _mm256_set1_epi32(static_cast<Int32>(stride)));
+    return _mm256_i32gather_ps(base, offsets, sizeof(float));
+  }
+
+  void Scatter(float* base, Uint32 stride) const
+  {
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, v);
+    for (Uint32 i = 0; i < 8; i++) {
+      base[i * stride] = lanes[i];
+    }
+  }
+
+  // Two Float4 deinterleaves joined into halves; cross-lane shuffles on eight floats would cost more than they save.
+  static void Deinterleave(const float* in, Float8& x, Float8& y, Float8& z)
+  {
+    Float4 x0 = 0.0f, y0 = 0.0f, z0 = 0.0f, x1 = 0.0f, y1 = 0.0f, z1 = 0.0f;
+    Float4::Deinterleave(in, x0, y0, z0);
+    Float4::Deinterleave(in + 12, x1, y1, z1);
+    x = _mm256_set_m128(x1.v, x0.v);
+    y = _mm256_set_m128(y1.v, y0.v);
+    z = _mm256_set_m128(z1.v, z0.v);
+  }
+
+  static void Interleave(Float8 x, Float8 y, Float8 z, float* out)
+  {
+    Float4::Interleave(_mm256_castps256_ps128(x.v), _mm256_castps256_ps128(y.v), _mm256_castps256_ps128(z.v), out);
+    Float4::Interleave(_mm256_extractf128_ps(x.v, 1), _mm256_extractf128_ps(y.v, 1), _mm256_extractf128_ps(z.v, 1),
+                       out + 12);
+  }
+};
+
+INLINE_LIB Float8 operator+(Float8 lhs, Float8 rhs) { return _mm256_add_ps(lhs.v, rhs.v); }
+INLINE_LIB Float8 operator-(Float8 lhs, Float8 rhs) { return _mm256_sub_ps(lhs.v, rhs.v); }
+INLINE_LIB Float8 operator*(Float8 lhs, Float8 rhs) { return _mm256_mul_ps(lhs.v, rhs.v); }
+#endif
+
+#if defined(NYCA_MATH_AVX2)
+using Wide = Float8;
+#elif defined(NYCA_MATH_SSE)
+using Wide = Float4;
+#else
+using Wide = Float1;
+#endif
+
+// Reads `Width` Transforms starting at `in` and writes their TRS matrices to `out`.
+template <typename F>
+INLINE_LIB void Compose(const Transform* in, Mat4* out)
+{
+  constexpr Uint32 stride = sizeof(Transform) / sizeof(float);
+  const float*     base = in->scale.data();
+  const F          sx = F::Gather(base + 0, stride), sy = F::Gather(base + 1, stride), sz = F::Gather(base + 2, stride);
+  const F          x = F::Gather(base + 3, stride), y = F::Gather(base + 4, stride), z = F::Gather(base + 5, stride);
+  const F          w = F::Gather(base + 6, stride);
+  const F          px = F::Gather(base + 7, stride), py = F::Gather(base + 8, stride), pz = F::Gather(base + 9, stride);
+
+  const F one = 1.0f, two = 2.0f, zero = 0.0f;
+  const F xx = x * x, yy = y * y, zz = z * z;
+  const F xy = x * y, xz = x * z, yz = y * z;
+  const F wx = w * x, wy = w * y, wz = w * z;
+
+  const F columns[16] = { (one - two * (yy + zz)) * sx, two * (xy + wz) * sx, two * (xz - wy) * sx, zero,
+                          two * (xy - wz) * sy, (one - two * (xx + zz)) * sy, two * (yz + wx) * sy, zero,
+                          two * (xz + wy) * sz, two * (yz - wx) * sz, (one - two * (xx + yy)) * sz, zero,
+                          px, py, pz, one };
+  for (Uint32 i = 0; i < 16; i++) {
+    columns[i].Scatter(out->m + i, 16);
+  }
+}
+
+// Reads `Width` packed xyz points starting at `in` and writes them transformed by `m` to `out`.
+template <typename F>
+INLINE_LIB void TransformPoints(const Mat4& m, const float* in, float* out)
+{
+  F x = 0.0f, y = 0.0f, z = 0.0f;
+  F::Deinterleave(in, x, y, z);
+  const F rx = F(m(0, 0)) * x + F(m(0, 1)) * y + F(m(0, 2)) * z + F(m(0, 3));
+  const F ry = F(m(1, 0)) * x + F(m(1, 1)) * y + F(m(1, 2)) * z + F(m(1, 3));
+  const F rz = F(m(2, 0)) * x + F(m(2, 1)) * y + F(m(2, 2)) * z + F(m(2, 3));
+  F::Interleave(rx, ry, rz, out);
+}
+
+}  // namespace Lanes
+
+// Writes the TRS matrix of each of `count` transforms. Rotations must be unit length.
+INLINE_LIB void Compose(const Transform* transforms, Mat4* out, Uint32 count)
+{
+  Uint32 i = 0;
+  for (; i + Lanes::Wide::Width <= count; i += Lanes::Wide::Width) {
+    Lanes::Compose<Lanes::Wide>(transforms + i, out + i);
+  }
+  for (; i < count; i++) {
+    Lanes::Compose<Lanes::Float1>(transforms + i, out + i);
+  }
+}
+
+// Transforms `count` points stored as packed xyz floats, the layout of a vertex position stream. `in` and `out` may
+// be the same buffer.
+INLINE_LIB void TransformPoints(const Mat4& m, const float* in, float* out, Uint32 count)
+{
+  Uint32 i = 0;
+  for (; i + Lanes::Wide::Width <= count; i += Lanes::Wide::Width) {
+    Lanes::TransformPoints<Lanes::Wide>(m, in + i * 3, out + i * 3);
+  }
+  for (; i < count; i++) {
+    Lanes::TransformPoints<Lanes::Float1>(m, in + i * 3, out + i * 3);
+  }
+}
+
+INLINE_LIB void TransformPoints(const Mat4& m, const Vec3* in, Vec3* out, Uint32 count)
+{
+  TransformPoints(m, &in->x, &out->x, count);
+}
+
+// Axis-aligned bounds of `count` packed xyz points. No points yield an inverted box, +inf below and -inf above.
+INLINE_LIB void Bounds(const float* points, Uint32 count, Vec3& lower, Vec3& upper)
+{
+  lower = { INFINITY, INFINITY, INFINITY };
+  upper = { -INFINITY, -INFINITY, -INFINITY };
+  for (Uint32 i = 0; i < count; i++) {
+    const float* p = points + i * 3;
+    lower = { std::fmin(lower.x, p[0]), std::fmin(lower.y, p[1]), std::fmin(lower.z, p[2]) };
+    upper = { std::fmax(upper.x, p[0]), std::fmax(upper.y, p[1]), std::fmax(upper.z, p[2]) };
+  }
+}
+
+// out[i] = lhs * rhs[i], e.g. a view-projection applied to every model matrix. `rhs` and `out` may alias.
+INLINE_LIB void Multiply(const Mat4& lhs, const Mat4* rhs, Mat4* out, Uint32 count)
+{
+#if defined(NYCA_MATH_AVX2)
+  // Two columns of the result per instruction: each half of a register holds one column of lhs.
+  const __m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs.m));
+  const __m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs.m + 4));
+  const __m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs.m + 8));
+  const __m256 c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs.m + 12));
+  for (Uint32 i = 0; i < count; i++) {
+    const float* r = rhs[i].m;
+    __m256       low = _mm256_mul_ps(c0, _mm256_setr_ps(r[0], r[0], r[0], r[0], r[4], r[4], r[4], r[4]));
+    low = _mm256_add_ps(low, _mm256_mul_ps(c1, _mm256_setr_ps(r[1], r[1], r[1], r[1], r[5], r[5], r[5], r[5])));
+    low = _mm256_add_ps(low, _mm256_mul_ps(c2, _mm256_setr_ps(r[2], r[2], r[2], r[2], r[6], r[6], r[6], r[6])));
+    low = _mm256_add_ps(low, _mm256_mul_ps(c3, _mm256_setr_ps(r[3], r[3], r[3], r[3], r[7], r[7], r[7], r[7])));
+    __m256 high = _mm256_mul_ps(c0, _mm256_setr_ps(r[8], r[8], r[8], r[8], r[12], r[12], r[12], r[12]));
+    high = _mm256_add_ps(high, _mm256_mul_ps(c1, _mm256_setr_ps(r[9], r[9], r[9], r[9], r[13], r[13], r[13], r[13])));
+    high = _mm256_add_ps(high,
+                         _mm256_mul_ps(c2, _mm256_setr_ps(r[10], r[10], r[10], r[10], r[14], r[14], r[14], r[14])));
+    high = _mm256_add_ps(high,
+                         _mm256_mul_ps(c3, _mm256_setr_ps(r[11], r[11], r[11], r[11], r[15], r[15], r[15], r[15])));
+    _mm256_storeu_ps(out[i].m, low);
+    _mm256_storeu_ps(out[i].m + 8, high);
+  }
+#else
+  for (Uint32 i = 0; i < count; i++) {
+    out[i] = lhs * rhs[i];
+  }
+#endif
+}
+
+}  // namespace NycaTech::Math
+
+#endif  // LINEAR_ALGEBRA_H
@@ -0,0 +1,187 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef LINEAR_ARENA_H
+#define LINEAR_ARENA_H
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+#include "types.h"
+#include "vector.h"
+
+namespace NycaTech {
+
+#ifndef INLINE_LIB
+#define INLINE_LIB inline
+#endif
+
+// Bump allocator over a chain of blocks. Allocating moves a cursor forward; nothing is freed on its own. Mark and
+// Rewind release everything allocated after a point and Reset releases it all, keeping the blocks for reuse, so an
+// arena that has warmed up stops touching the heap. Not thread safe; give each thread its own.
+class LinearArena final {
+public:
+  struct Marker {
+    Uint32 block;
+    Uint8* cursor;
+  };
+
+  INLINE_LIB explicit LinearArena(Uint64 blockSize = DefaultBlockSize);
+  LinearArena(LinearArena&&) = delete;
+  LinearArena(const LinearArena&) = delete;
+  INLINE_LIB ~LinearArena();
+
+public:
+  INLINE_LIB void*  Allocate(Uint64 bytes, Uint64 alignment);
+  INLINE_LIB void   Deallocate(void* memory, Uint64 bytes, Uint64 alignment);
+  INLINE_LIB Marker Mark() const;
+  INLINE_LIB void   Rewind(const Marker& marker);
+  INLINE_LIB void   Reset();
+  INLINE_LIB Uint64 Capacity() const;
+
+  static constexpr Uint64 DefaultBlockSize = 64 * 1024;
+  static constexpr Uint64 BlockAlign = 64;
+
+private:
+  struct Block {
+    Uint8* data;
+    Uint64 size;
+  };
+
+  INLINE_LIB void* AllocateSlow(Uint64 bytes, Uint64 alignment);
+  INLINE_LIB void* TryBump(Uint64 bytes, Uint64 alignment);
+  INLINE_LIB void  Select(Uint32 index);
+
+private:
+  Vector<Block> blocks;
+  Uint64        blockSize;
+  Uint32        blockIndex;
+  Uint8*        cursor;
+  Uint8*        limit;
+};
+
+// Allocator handing containers memory from a LinearArena, e.g. Vector<T, ArenaAllocator>. Deallocate only gives
+// memory back when it is the most recent allocation; the rest returns with the arena's next Rewind or Reset.
+struct ArenaAllocator {
+  explicit ArenaAllocator(LinearArena& arena)
+      : arena(&arena)
+  {
+  }
+
+  void* Allocate(Uint64 bytes, Uint64 alignment) { return arena->Allocate(bytes, alignment); }
+  void  Deallocate(void* memory, Uint64 bytes, Uint64 alignment) { arena->Deallocate(memory, bytes, alignment); }
+
+  LinearArena* arena;
+};
+
+// Rewinds an arena to where it was when the scope opened.
+class ArenaScope final {
+public:
+   explicit ArenaScope(LinearArena& arena)
+      : arena(arena), marker(arena.Mark())
+  {
+  }
+   ArenaScope(ArenaScope&&) = delete;
+   ArenaScope(const ArenaScope&) = delete;
+  ~ArenaScope() { arena.Rewind(marker); }
+
+private:
+  LinearArena&        arena;
+  LinearArena::Marker marker;
+};
+
+INLINE_LIB LinearArena::LinearArena(const Uint64 blockSize)
+    : blockSize(blockSize), blockIndex(0), cursor(nullptr), limit(nullptr)
+{
+}
+
+INLINE_LIB LinearArena::~LinearArena()
+{
+  for (const Block& block: blocks) {
+    ::operator delete(block.data, std::align_val_t(BlockAlign));
+  }
+}
+
+INLINE_LIB void* LinearArena::Allocate(const Uint64 bytes, const Uint64 alignment)
+{
+  void* memory = TryBump(bytes, alignment);
+  return memory ? memory : AllocateSlow(bytes, alignment);
+}
+
+INLINE_LIB void LinearArena::Deallocate(void* memory, const Uint64 bytes, Uint64)
+{
+  if (static_cast<Uint8*>(memory) + bytes == cursor) {
+    cursor = static_cast<Uint8*>(memory);
+  }
+}
+
+INLINE_LIB LinearArena::Marker LinearArena::Mark() const
+{
+  return { blockIndex, cursor };
+}
+
+INLINE_LIB void LinearArena::Rewind(const Marker& marker)
+{
+  if (marker.cursor) {
+    Select(marker.block);
+    cursor = marker.cursor;
+  }
+  else {
+    Reset();
+  }
+}
+
+INLINE_LIB void LinearArena::Reset()
+{
+  if (!blocks.IsEmpty()) {
+    Select(0);
+  }
+}
+
+INLINE_LIB Uint64 LinearArena::Capacity() const
+{
+  Uint64 capacity = 0;
+  for (const Block& block: blocks) {
+    capacity += block.size;
+  }
+  return capacity;
+}
+
+INLINE_LIB void* LinearArena::TryBump(const Uint64 bytes, const Uint64 alignment)
+{
+  const uintptr_t aligned = (reinterpret_cast<uintptr_t>(cursor) + alignment - 1) & ~(alignment - 1);
+  if (!limit || aligned + bytes > reinterpret_cast<uintptr_t>(limit)) {
+    return nullptr;
+  }
+  cursor = reinterpret_cast<Uint8*>(aligned + bytes);
+  return reinterpret_cast<void*>(aligned);
+}
+
+// Moves on to the next block that fits, reusing blocks left over from before a Rewind or Reset, and adds a block at
+// the end once none does. Requests bigger than the block size get a block of their own.
+INLINE_LIB void* LinearArena::AllocateSlow(const Uint64 bytes, const Uint64 alignment)
+{
+  for (Uint32 next = limit ? blockIndex + 1 : 0; next < blocks.Count(); next++) {
+    Select(next);
+    if (void* memory = TryBump(bytes, alignment)) {
+      return memory;
+    }
+  }
+  const Uint64 size = std::max(blockSize, bytes + (alignment > BlockAlign ? alignment : 0));
+  blocks.Insert({ static_cast<Uint8*>(::operator new(size, std::align_val_t(BlockAlign))), size });
+  Select(blocks.Count() - 1);
+  return TryBump(bytes, alignment);
+}
+
+INLINE_LIB void LinearArena::Select(const Uint32 index)
+{
+  blockIndex = index;
+  cursor = blocks[index].data;
+  limit = blocks[index].data + blocks[index].size;
+}
+
+}  // namespace NycaTech
+
+#endif  // LINEAR_ARENA_H
@@ -0,0 +1,153 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "types.h"
+
+namespace NycaTech {
+
+#ifndef INLINE_LIB
+#define INLINE_LIB inline
+#endif
+
+// A whole file mapped into memory. Private mappings are copy-on-write: writes land in the process' own pages and never
+// reach the file, which lets loaders adopt the mapping as mutable storage.
+class MappedFile final {
+public:
+  enum class Mode : Uint32 {
+    ReadOnly = 0,
+    Private = 1,
+  };
+
+  INLINE_LIB static MappedFile* Open(const char* path, Mode mode = Mode::ReadOnly);
+
+  MappedFile(MappedFile&&) = delete;
+  MappedFile(const MappedFile&) = delete;
+  INLINE_LIB ~MappedFile();
+
+public:
+  INLINE_LIB Uint8*       Data();
+  INLINE_LIB const Uint8* Data() const;
+  INLINE_LIB Uint64       Size() const;
+
+private:
+  MappedFile() = default;
+
+private:
+  Uint8* data = nullptr;
+  Uint64 size = 0;
+#ifdef _WIN32
+  HANDLE file = INVALID_HANDLE_VALUE;
+  HANDLE mapping = nullptr;
+#endif
+};
+
+#ifdef _WIN32
+
+INLINE_LIB MappedFile* MappedFile::Open(const char* path, Mode mode)
+{
+  auto* mapped = new MappedFile;
+  mapped->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  LARGE_INTEGER fileSize;
+  if (mapped->file == INVALID_HANDLE_VALUE || !GetFileSizeEx(mapped->file, &fileSize) || fileSize.QuadPart == 0) {
+    delete mapped;
+    return nullptr;
+  }
+  mapped->size = static_cast<Uint64>(fileSize.QuadPart);
+
+  const DWORD protection = mode == Mode::Private ? PAGE_WRITECOPY : PAGE_READONLY;
+  const DWORD access = mode == Mode::Private ? FILE_MAP_COPY : FILE_MAP_READ;
+  mapped->mapping = CreateFileMappingA(mapped->file, nullptr, protection, 0, 0, nullptr);
+  if (!mapped->mapping) {
+    delete mapped;
+    return nullptr;
+  }
+  mapped->data = static_cast<Uint8*>(MapViewOfFile(mapped->mapping, access, 0, 0, 0));
+  if (!mapped->data) {
+    delete mapped;
+    return nullptr;
+  }
+  return mapped;
+}
+
+INLINE_LIB MappedFile::~MappedFile()
+{
+  if (data) {
+    UnmapViewOfFile(data);
+  }
+  if (mapping) {
+    CloseHandle(mapping);
+  }
+  if (file != INVALID_HANDLE_VALUE) {
+    CloseHandle(file);
+  }
+}
+
+#else
+
+INLINE_LIB MappedFile* MappedFile::Open(const char* path, Mode mode)
+{
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0) {
+    close(fd);
+    return nullptr;
+  }
+
+  const int protection = mode == Mode::Private ? PROT_READ | PROT_WRITE : PROT_READ;
+  void*     address = mmap(nullptr, info.st_size, protection, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (address == MAP_FAILED) {
+    return nullptr;
+  }
+
+  auto* mapped = new MappedFile;
+  mapped->data = static_cast<Uint8*>(address);
+  mapped->size = static_cast<Uint64>(info.st_size);
+  return mapped;
+}
+
+INLINE_LIB MappedFile::~MappedFile()
+{
+  if (data) {
+    munmap(data, size);
+  }
+}
+
+#endif
+
+INLINE_LIB Uint8* MappedFile::Data()
+{
+  return data;
+}
+
+INLINE_LIB const Uint8* MappedFile::Data() const
+{
+  return data;
+}
+
+INLINE_LIB Uint64 MappedFile::Size() const
+{
+  return size;
+}
+
+}  // namespace NycaTech
+
+#endif  // MAPPED_FILE_H
@@ -0,0 +1,212 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include <algorithm>
+#include <bit>
+#include <new>
+#include <utility>
+
+#include "allocator.h"
+#include "types.h"
+
+namespace NycaTech {
+
+#ifndef INLINE_LIB
+#define INLINE_LIB inline
+#endif
+
+// Bounded lock-free queue for any number of producers and consumers. Capacity is rounded up to a power of two.
+// Every cell carries a sequence number saying whose turn it is: the producer for position p waits for sequence p, the
+// consumer for sequence p + 1. Threads claim positions with a compare-and-swap on the enqueue or dequeue index, which
+// sit on cache lines of their own. A batch claims a run of consecutive ready cells with a single compare-and-swap.
+template <typename T, typename Allocator = HeapAllocator>
+class MpmcQueue final {
+public:
+  INLINE_LIB explicit MpmcQueue(Uint32 capacity, const Allocator& allocator = Allocator());
+  MpmcQueue(MpmcQueue&&) = delete;
+  MpmcQueue(const MpmcQueue&) = delete;
+  INLINE_LIB ~MpmcQueue();
+
+public:
+  template <typename... Args>
+  INLINE_LIB bool   TryEmplace(Args&&... args);
+  INLINE_LIB bool   TryPush(const T& element);
+  INLINE_LIB bool   TryPush(T&& element);
+  INLINE_LIB Uint32 PushBatch(const T* elements, Uint32 count);
+  INLINE_LIB bool   TryPop(T& out);
+  INLINE_LIB Uint32 PopBatch(T* out, Uint32 max);
+
+  // Approximate while other threads are pushing or popping.
+  INLINE_LIB Uint32 Count() const;
+  INLINE_LIB bool   IsEmpty() const;
+  INLINE_LIB Uint32 Capacity() const;
+
+private:
+  struct Cell {
+    Atomic<Uint64> sequence;
+    alignas(T) Uint8 storage[sizeof(T)];
+
+    T* Element() { return std::launder(reinterpret_cast<T*>(storage)); }
+  };
+
+  // Claims up to `wanted` consecutive cells starting at `index` whose sequence is position + `lag`. Returns the first
+  // claimed position in `start` and the number of cells claimed.
+  INLINE_LIB Uint32 Claim(Atomic<Uint64>& index, Uint64 lag, Uint32 wanted, Uint64& start);
+
+private:
+  alignas(CacheLineSize) Atomic<Uint64> enqueueIndex;
+  alignas(CacheLineSize) Atomic<Uint64> dequeueIndex;
+  alignas(CacheLineSize) Cell*          cells;
+  Uint64                                mask;
+  Uint32                                capacity;
+  [[no_unique_address]] Allocator       allocator;
+};
+
+template <typename T, typename Allocator>
+INLINE_LIB MpmcQueue<T, Allocator>::MpmcQueue(const Uint32 capacity, const Allocator& allocator)
+    : enqueueIndex(0), dequeueIndex(0), capacity(std::bit_ceil(std::max(capacity, 2u))), allocator(allocator)
+{
+  mask = Self.capacity - 1;
+  cells = static_cast<Cell*>(Self.allocator.Allocate(sizeof(Cell) * Self.capacity, alignof(Cell)));
+  for (Uint32 i = 0; i < Self.capacity; i++) {
+    new (&cells[i].sequence) Atomic<Uint64>(i);
+  }
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB MpmcQueue<T, Allocator>::~MpmcQueue()
+{
+  const Uint64 end = enqueueIndex.load(std::memory_order_acquire);
+  for (Uint64 position = dequeueIndex.load(std::memory_order_acquire); position != end; position++) {
+    cells[position & mask].Element()->~T();
+  }
+  allocator.Deallocate(cells, sizeof(Cell) * capacity, alignof(Cell));
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+INLINE_LIB bool MpmcQueue<T, Allocator>::TryEmplace(Args&&... args)
+{
+  Uint64 position;
+  if (Claim(enqueueIndex, 0, 1, position) == 0) {
+    return false;
+  }
+  Cell& cell = cells[position & mask];
+  new (cell.storage) T(std::forward<Args>(args)...);
+  cell.sequence.store(position + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB bool MpmcQueue<T, Allocator>::TryPush(const T& element)
+{
+  return TryEmplace(element);
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB bool MpmcQueue<T, Allocator>::TryPush(T&& element)
+{
+  return TryEmplace(std::move(element));
+}
+
+// Pushes as many of `elements` as the queue has consecutive room for and returns how many that was.
+template <typename T, typename Allocator>
+INLINE_LIB Uint32 MpmcQueue<T, Allocator>::PushBatch(const T* elements, const Uint32 count)
+{
+  Uint64       start;
+  const Uint32 pushed = Claim(enqueueIndex, 0, count, start);
+  for (Uint32 i = 0; i < pushed; i++) {
+    Cell& cell = cells[(start + i) & mask];
+    new (cell.storage) T(elements[i]);
+    cell.sequence.store(start + i + 1, std::memory_order_release);
+  }
+  return pushed;
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB bool MpmcQueue<T, Allocator>::TryPop(T& out)
+{
+  return PopBatch(&out, 1) == 1;
+}
+
+// Moves up to `max` consecutive elements into `out` and returns how many that was.
+template <typename T, typename Allocator>
+INLINE_LIB Uint32 MpmcQueue<T, Allocator>::PopBatch(T* out, const Uint32 max)
+{
+  Uint64       start;
+  const Uint32 popped = Claim(dequeueIndex, 1, max, start);
+  for (Uint32 i = 0; i < popped; i++) {
+    Cell& cell = cells[(start + i) & mask];
+    T*    element = cell.Element();
+    out[i] = std::move(*element);
+    element->~T();
+    cell.sequence.store(start + i + capacity, std::memory_order_release);
+  }
+  return popped;
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB Uint32 MpmcQueue<T, Allocator>::Count() const
+{
+  const Uint64 dequeued = dequeueIndex.load(std::memory_order_acquire);
+  const Uint64 enqueued = enqueueIndex.load(std::memory_order_acquire);
+  return enqueued > dequeued ? static_cast<Uint32>(std::min<Uint64>(enqueued - dequeued, capacity)) : 0;
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB bool MpmcQueue<T, Allocator>::IsEmpty() const
+{
+  return Count() == 0;
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB Uint32 MpmcQueue<T, Allocator>::Capacity() const
+{
+  return capacity;
+}
+
+// A cell whose sequence equals position + lag can only change hands through the thread that claims that position,
+// so the cells counted ready before the compare-and-swap are still ready when it succeeds.
+template <typename T, typename Allocator>
+INLINE_LIB Uint32 MpmcQueue<T, Allocator>::Claim(Atomic<Uint64>& index,
+                                                 const Uint64    lag,
+                                                 const Uint32    wanted,
+                                                 Uint64&         start)
+{
+  if (wanted == 0) {
+    return 0;
+  }
+  Uint64 position = index.load(std::memory_order_relaxed);
+  for (;;) {
+    Uint32 ready = 0;
+    for (; ready < wanted; ready++) {
+      const Uint64 sequence = cells[(position + ready) & mask].sequence.load(std::memory_order_acquire);
+      if (sequence != position + ready + lag) {
+        break;
+      }
+    }
+
+    if (ready > 0) {
+      if (index.compare_exchange_weak(position, position + ready, std::memory_order_relaxed)) {
+        start = position;
+        return ready;
+      }
+      continue;
+    }
+
+    // Nothing ready at `position`: either the queue is full (empty, for consumers) or another thread claimed it.
+    const Uint64 sequence = cells[position & mask].sequence.load(std::memory_order_acquire);
+    if (static_cast<Int64>(sequence - (position + lag)) < 0) {
+      return 0;
+    }
+    position = index.load(std::memory_order_relaxed);
+  }
+}
+
+}  // namespace NycaTech
+
+#endif  // MPMC_QUEUE_H
@@ -0,0 +1,21 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include "allocator.h"
+#include "types.h"
+#include "vector.h"
+
+namespace NycaTech {
+
+// Vector that keeps its first N elements inside the object and only asks the allocator for memory once it grows past
+// them.
+template <typename T, Uint32 N, typename Allocator = HeapAllocator>
+using SmallVector = Vector<T, Allocator, N>;
+
+}  // namespace NycaTech
+
+#endif  // SMALL_VECTOR_H
@@ -0,0 +1,253 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef SPARSE_SET_H
+#define SPARSE_SET_H
+
+#include <algorithm>
+#include <utility>
+
+#include "allocator.h"
+#include "types.h"
+#include "vector.h"
+
+namespace NycaTech {
+
+#ifndef INLINE_LIB
+#define INLINE_LIB inline
+#endif
+
+// Map from small integer keys, such as entity indices, to values kept in one packed array. A paged sparse array
+// gives each key its position in the packed array, so insert, erase and lookup are O(1) and iterating touches only
+// live values. Erase moves the last value into the hole, which keeps the array packed but does not keep its order.
+// Pages of the sparse array are allocated the first time a key falls into them.
+template <typename T, typename Allocator = HeapAllocator>
+class SparseSet final {
+public:
+  INLINE_LIB SparseSet();
+  INLINE_LIB explicit SparseSet(const Allocator& allocator);
+  SparseSet(SparseSet&&) = delete;
+  SparseSet(const SparseSet&) = delete;
+  INLINE_LIB ~SparseSet();
+
+public:
+  // Inserting a key that is already present replaces its value.
+  template <typename... Args>
+  INLINE_LIB T& Emplace(Uint32 key, Args&&... args);
+  INLINE_LIB T& Insert(Uint32 key, const T& value);
+  INLINE_LIB T& Insert(Uint32 key, T&& value);
+
+  INLINE_LIB bool     Erase(Uint32 key);
+  INLINE_LIB bool     Contains(Uint32 key) const;
+  INLINE_LIB T*       Find(Uint32 key);
+  INLINE_LIB const T* Find(Uint32 key) const;
+  INLINE_LIB void     Clear();
+  INLINE_LIB Uint32   Count() const;
+  INLINE_LIB bool     IsEmpty() const;
+
+  // Packed arrays; Keys()[i] is the key of Values()[i].
+  INLINE_LIB const Uint32* Keys() const;
+  INLINE_LIB T*            Values();
+  INLINE_LIB const T*      Values() const;
+
+  static constexpr Uint32 PageSize = 1024;
+  static constexpr Uint32 Absent = UINT32_MAX;
+
+public:
+  INLINE_LIB T*       begin();
+  INLINE_LIB const T* begin() const;
+  INLINE_LIB T*       end();
+  INLINE_LIB const T* end() const;
+
+private:
+  INLINE_LIB Uint32  PositionOf(Uint32 key) const;
+  INLINE_LIB Uint32& SlotFor(Uint32 key);
+
+private:
+  Vector<Uint32*, Allocator>      pages;
+  Vector<Uint32, Allocator>       keys;
+  Vector<T, Allocator>            values;
+  [[no_unique_address]] Allocator allocator;
+};
+
+template <typename T, typename Allocator>
+INLINE_LIB SparseSet<T, Allocator>::SparseSet()
+    : SparseSet(Allocator())
+{
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB SparseSet<T, Allocator>::SparseSet(const Allocator& allocator)
+    : pages(allocator), keys(allocator), values(allocator), allocator(allocator)
+{
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB SparseSet<T, Allocator>::~SparseSet()
+{
+  for (Uint32* page: pages) {
+    if (page) {
+      allocator.Deallocate(page, sizeof(Uint32) * PageSize, alignof(Uint32));
+    }
+  }
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+INLINE_LIB T& SparseSet<T, Allocator>::Emplace(const Uint32 key, Args&&... args)
+{
+  Uint32& slot = SlotFor(key);
+  if (slot != Absent) {
+    values[slot] = T(std::forward<Args>(args)...);
+    return values[slot];
+  }
+  slot = values.Count();
+  keys.Insert(key);
+  return values.EmplaceBack(std::forward<Args>(args)...);
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB T& SparseSet<T, Allocator>::Insert(const Uint32 key, const T& value)
+{
+  return Emplace(key, value);
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB T& SparseSet<T, Allocator>::Insert(const Uint32 key, T&& value)
+{
+  return Emplace(key, std::move(value));
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB bool SparseSet<T, Allocator>::Erase(const Uint32 key)
+{
+  const Uint32 position = PositionOf(key);
+  if (position == Absent) {
+    return false;
+  }
+
+  const Uint32 last = values.Count() - 1;
+  if (position != last) {
+    values[position] = std::move(values[last]);
+    keys[position] = keys[last];
+    pages[keys[last] / PageSize][keys[last] % PageSize] = position;
+  }
+  values.RemoveLast();
+  keys.RemoveLast();
+  pages[key / PageSize][key % PageSize] = Absent;
+  return true;
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB bool SparseSet<T, Allocator>::Contains(const Uint32 key) const
+{
+  return PositionOf(key) != Absent;
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB T* SparseSet<T, Allocator>::Find(const Uint32 key)
+{
+  const Uint32 position = PositionOf(key);
+  return position != Absent ? &values[position] : nullptr;
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB const T* SparseSet<T, Allocator>::Find(const Uint32 key) const
+{
+  const Uint32 position = PositionOf(key);
+  return position != Absent ? &values[position] : nullptr;
+}
+
+// Keeps the pages, so keys inserted again after a Clear do not allocate.
+template <typename T, typename Allocator>
+INLINE_LIB void SparseSet<T, Allocator>::Clear()
+{
+  for (const Uint32 key: keys) {
+    pages[key / PageSize][key % PageSize] = Absent;
+  }
+  keys.Clear();
+  values.Clear();
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB Uint32 SparseSet<T, Allocator>::Count() const
+{
+  return values.Count();
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB bool SparseSet<T, Allocator>::IsEmpty() const
+{
+  return values.IsEmpty();
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB const Uint32* SparseSet<T, Allocator>::Keys() const
+{
+  return keys.Data();
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB T* SparseSet<T, Allocator>::Values()
+{
+  return values.Data();
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB const T* SparseSet<T, Allocator>::Values() const
+{
+  return values.Data();
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB T* SparseSet<T, Allocator>::begin()
+{
+  return values.begin();
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB const T* SparseSet<T, Allocator>::begin() const
+{
+  return values.begin();
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB T* SparseSet<T, Allocator>::end()
+{
+  return values.end();
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB const T* SparseSet<T, Allocator>::end() const
+{
+  return values.end();
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB Uint32 SparseSet<T, Allocator>::PositionOf(const Uint32 key) const
+{
+  const Uint32 page = key / PageSize;
+  if (page >= pages.Count() || !pages[page]) {
+    return Absent;
+  }
+  return pages[page][key % PageSize];
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB Uint32& SparseSet<T, Allocator>::SlotFor(const Uint32 key)
+{
+  const Uint32 page = key / PageSize;
+  while (pages.Count() <= page) {
+    pages.Insert(nullptr);
+  }
+  if (!pages[page]) {
+    pages[page] = static_cast<Uint32*>(allocator.Allocate(sizeof(Uint32) * PageSize, alignof(Uint32)));
+    std::fill(pages[page], pages[page] + PageSize, Absent);
+  }
+  return pages[page][key % PageSize];
+}
+
+}  // namespace NycaTech
+
+#endif  // SPARSE_SET_H
@@ -0,0 +1,194 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <algorithm>
+#include <bit>
+#include <new>
+#include <utility>
+
+#include "allocator.h"
+#include "types.h"
+
+namespace NycaTech {
+
+#ifndef INLINE_LIB
+#define INLINE_LIB inline
+#endif
+
+// Bounded lock-free ring buffer between exactly one producer thread and one consumer thread. Capacity is rounded up
+// to a power of two. Each side owns a cache line holding its index and the last index it read from the other side,
+// so the two only exchange a line when the queue looks full or empty. Batches publish many elements with one store.
+template <typename T, typename Allocator = HeapAllocator>
+class SpscQueue final {
+public:
+  INLINE_LIB explicit SpscQueue(Uint32 capacity, const Allocator& allocator = Allocator());
+  SpscQueue(SpscQueue&&) = delete;
+  SpscQueue(const SpscQueue&) = delete;
+  INLINE_LIB ~SpscQueue();
+
+public:
+  // Producer side.
+  template <typename... Args>
+  INLINE_LIB bool   TryEmplace(Args&&... args);
+  INLINE_LIB bool   TryPush(const T& element);
+  INLINE_LIB bool   TryPush(T&& element);
+  INLINE_LIB Uint32 PushBatch(const T* elements, Uint32 count);
+
+  // Consumer side.
+  INLINE_LIB bool   TryPop(T& out);
+  INLINE_LIB Uint32 PopBatch(T* out, Uint32 max);
+
+  // Either side; exact only while the other side is idle.
+  INLINE_LIB Uint32 Count() const;
+  INLINE_LIB bool   IsEmpty() const;
+  INLINE_LIB Uint32 Capacity() const;
+
+private:
+  INLINE_LIB Uint32 Free(Uint64 tail, Uint32 wanted);
+  INLINE_LIB Uint32 Filled(Uint64 head, Uint32 wanted);
+
+  struct alignas(CacheLineSize) Producer {
+    Atomic<Uint64> tail = 0;
+    Uint64         cachedHead = 0;
+  };
+
+  struct alignas(CacheLineSize) Consumer {
+    Atomic<Uint64> head = 0;
+    Uint64         cachedTail = 0;
+  };
+
+private:
+  Producer                        producer;
+  Consumer                        consumer;
+  alignas(CacheLineSize) T*       slots;
+  Uint64                          mask;
+  Uint32                          capacity;
+  [[no_unique_address]] Allocator allocator;
+};
+
+template <typename T, typename Allocator>
+INLINE_LIB SpscQueue<T, Allocator>::SpscQueue(const Uint32 capacity, const Allocator& allocator)
+    : capacity(std::bit_ceil(std::max(capacity, 1u))), allocator(allocator)
+{
+  mask = Self.capacity - 1;
+  slots = static_cast<T*>(Self.allocator.Allocate(sizeof(T) * Self.capacity, alignof(T)));
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB SpscQueue<T, Allocator>::~SpscQueue()
+{
+  const Uint64 tail = producer.tail.load(std::memory_order_acquire);
+  for (Uint64 head = consumer.head.load(std::memory_order_relaxed); head != tail; head++) {
+    slots[head & mask].~T();
+  }
+  allocator.Deallocate(slots, sizeof(T) * capacity, alignof(T));
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+INLINE_LIB bool SpscQueue<T, Allocator>::TryEmplace(Args&&... args)
+{
+  const Uint64 tail = producer.tail.load(std::memory_order_relaxed);
+  if (Free(tail, 1) == 0) {
+    return false;
+  }
+  new (slots + (tail & mask)) T(std::forward<Args>(args)...);
+  producer.tail.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB bool SpscQueue<T, Allocator>::TryPush(const T& element)
+{
+  return TryEmplace(element);
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB bool SpscQueue<T, Allocator>::TryPush(T&& element)
+{
+  return TryEmplace(std::move(element));
+}
+
+// Pushes as many of `elements` as fit and returns how many that was.
+template <typename T, typename Allocator>
+INLINE_LIB Uint32 SpscQueue<T, Allocator>::PushBatch(const T* elements, const Uint32 count)
+{
+  const Uint64 tail = producer.tail.load(std::memory_order_relaxed);
+  const Uint32 pushed = Free(tail, count);
+  for (Uint32 i = 0; i < pushed; i++) {
+    new (slots + ((tail + i) & mask)) T(elements[i]);
+  }
+  producer.tail.store(tail + pushed, std::memory_order_release);
+  return pushed;
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB bool SpscQueue<T, Allocator>::TryPop(T& out)
+{
+  return PopBatch(&out, 1) == 1;
+}
+
+// Moves up to `max` elements into `out` and returns how many that was.
+template <typename T, typename Allocator>
+INLINE_LIB Uint32 SpscQueue<T, Allocator>::PopBatch(T* out, const Uint32 max)
+{
+  const Uint64 head = consumer.head.load(std::memory_order_relaxed);
+  const Uint32 popped = Filled(head, max);
+  for (Uint32 i = 0; i < popped; i++) {
+    T& slot = slots[(head + i) & mask];
+    out[i] = std::move(slot);
+    slot.~T();
+  }
+  consumer.head.store(head + popped, std::memory_order_release);
+  return popped;
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB Uint32 SpscQueue<T, Allocator>::Count() const
+{
+  const Uint64 head = consumer.head.load(std::memory_order_acquire);
+  return static_cast<Uint32>(producer.tail.load(std::memory_order_acquire) - head);
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB bool SpscQueue<T, Allocator>::IsEmpty() const
+{
+  return Count() == 0;
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB Uint32 SpscQueue<T, Allocator>::Capacity() const
+{
+  return capacity;
+}
+
+// Room for up to `wanted` elements at `tail`, rereading the consumer's index only when the cached one falls short.
+template <typename T, typename Allocator>
+INLINE_LIB Uint32 SpscQueue<T, Allocator>::Free(const Uint64 tail, const Uint32 wanted)
+{
+  Uint64 room = capacity - (tail - producer.cachedHead);
+  if (room < wanted) {
+    producer.cachedHead = consumer.head.load(std::memory_order_acquire);
+    room = capacity - (tail - producer.cachedHead);
+  }
+  return static_cast<Uint32>(std::min<Uint64>(room, wanted));
+}
+
+template <typename T, typename Allocator>
+INLINE_LIB Uint32 SpscQueue<T, Allocator>::Filled(const Uint64 head, const Uint32 wanted)
+{
+  Uint64 filled = consumer.cachedTail - head;
+  if (filled < wanted) {
+    consumer.cachedTail = producer.tail.load(std::memory_order_acquire);
+    filled = consumer.cachedTail - head;
+  }
+  return static_cast<Uint32>(std::min<Uint64>(filled, wanted));
+}
+
+}  // namespace NycaTech
+
+#endif  // SPSC_QUEUE_H
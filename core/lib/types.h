@@ -2,12 +2,16 @@
 #define TYPES_H
 
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
 #include <map>
+#include <mutex>
+#include <span>
 #include <sstream>
 #include <thread>
-#include <unordered_map>
 
 namespace NycaTech {
 
@@ -18,9 +22,7 @@ using namespace std::chrono;
 using namespace std::this_thread;
 
 typedef high_resolution_clock Time;
-
-template <typename K, typename V>
-using HashMap = std::unordered_map<K, V>;
+typedef steady_clock          MonotonicTime;
 
 template <typename K, typename V>
 using RedBlackMap = std::map<K, V>;
@@ -28,10 +30,25 @@ using RedBlackMap = std::map<K, V>;
 template <typename T>
 using StreamIterator = std::istreambuf_iterator<T>;
 
+template <typename T>
+using Atomic = std::atomic<T>;
+
+template <typename T>
+using Deque = std::deque<T>;
+
+template <typename T>
+using Span = std::span<T>;
+
 using Thread = std::thread;
+using Mutex = std::mutex;
+using LockGuard = std::lock_guard<std::mutex>;
+using UniqueLock = std::unique_lock<std::mutex>;
+using ConditionVariable = std::condition_variable;
 using StreamReader = std::ifstream;
+using StreamWriter = std::ofstream;
 using StringStream = std::stringstream;
 
+using Int8 = int8_t;
 using Uint8 = uint8_t;
 using Uint16 = uint16_t;
 using Uint32 = uint32_t;
@@ -44,17 +61,23 @@ using String = std::string;
 using Exception = std::exception;
 using RuntimeError = std::runtime_error;
 
+// Size of the unit cores exchange. Data written by different threads is kept this far apart to avoid false sharing.
+constexpr Uint32 CacheLineSize = 64;
+
 using Vect3 = std::array<float, 3>;
 using Quad = std::array<float, 4>;
 
 struct Transform {
   Transform(Transform&&) = default;
   Transform(const Transform&) = default;
+  Transform& operator=(Transform&&) = default;
+  Transform& operator=(const Transform&) = default;
 
+  // Identity: unit scale, no rotation (quaternion x, y, z, w), at the origin.
   Transform()
-      : position(), rotation(), scale(){};
+      : scale{ 1.0f, 1.0f, 1.0f }, rotation{ 0.0f, 0.0f, 0.0f, 1.0f }, position(){};
   Transform(const Vect3& position, const Quad& rotation, const Vect3& scale)
-      : position(position), rotation(rotation), scale(scale){};
+      : scale(scale), rotation(rotation), position(position){};
 
   Vect3 scale;
   Quad  rotation;
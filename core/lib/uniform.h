@@ -5,12 +5,14 @@
 #ifndef UNIFORM_H
 #define UNIFORM_H
 
+#include "linear_algebra.h"
+
 namespace NycaTech {
 
 struct Uniform final {
-  float model[16];
-  float view[16];
-  float proj[16];
+  Math::Mat4 model;
+  Math::Mat4 view;
+  Math::Mat4 proj;
 };
 
 } // NycaTech
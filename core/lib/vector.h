@@ -5,9 +5,17 @@
 #ifndef VECTOR_H
 #define VECTOR_H
 
-#include "types.h"
-#include <cstdlib>
+#include <algorithm>
+#include <cstring>
 #include <functional>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "allocator.h"
+#include "types.h"
 
 namespace NycaTech {
 
@@ -15,26 +23,53 @@ namespace NycaTech {
 #define INLINE_LIB inline
 #endif
 
+// Room for InlineCount elements inside a Vector, so small ones never ask their allocator for memory.
+template <typename T, Uint32 InlineCount>
+struct InlineStorage {
+  T*       Data() { return reinterpret_cast<T*>(bytes); }
+  const T* Data() const { return reinterpret_cast<const T*>(bytes); }
+
+  alignas(T) Uint8 bytes[sizeof(T) * InlineCount];
+};
+
 template <typename T>
+struct InlineStorage<T, 0> {
+  T*       Data() { return nullptr; }
+  const T* Data() const { return nullptr; }
+};
+
+// Growable array. Elements are constructed and destroyed in place, moves steal the buffer, and growth relocates
+// with memcpy when T is trivially copyable. CountMut, OverrideCount and AdjustSize touch the count without
+// constructing anything; they exist for APIs that fill Data() directly and are limited to trivially copyable T.
+// A non-zero InlineCount keeps that many elements inside the object before the allocator is used at all; moving
+// such a Vector while it still fits inline moves its elements one by one instead of stealing a buffer.
+template <typename T, typename Allocator = HeapAllocator, Uint32 InlineCount = 0>
 class Vector {
 public:
-  INLINE_LIB explicit Vector(Uint32 count = 0);
-  INLINE_LIB explicit Vector(std::initializer_list<T> init);
+  INLINE_LIB Vector();
+  INLINE_LIB explicit Vector(const Allocator& allocator);
+  INLINE_LIB explicit Vector(Uint32 count, const Allocator& allocator = Allocator());
+  INLINE_LIB explicit Vector(std::initializer_list<T> init, const Allocator& allocator = Allocator());
 
-  INLINE_LIB Vector(Vector&& other);
+  INLINE_LIB Vector(Vector&& other) noexcept;
   INLINE_LIB Vector(const Vector& other);
+  INLINE_LIB ~Vector();
 
-  INLINE_LIB Vector& operator=(Vector&& other);
+  INLINE_LIB Vector& operator=(Vector&& other) noexcept;
   INLINE_LIB Vector& operator=(const Vector& other);
-  INLINE_LIB Vector& operator=(std::vector<T>);
+  INLINE_LIB Vector& operator=(const std::vector<T>& other);
 
 public:
   INLINE_LIB bool     Resize(Uint32 newSize);
+  INLINE_LIB bool     Reserve(Uint32 newCapacity);
   INLINE_LIB bool     Insert(const T& element);
+  INLINE_LIB bool     Insert(T&& element);
   INLINE_LIB bool     At(Uint32 index, T* elem) const;
   INLINE_LIB bool     At(Uint32 index, T** elem) const;
   INLINE_LIB bool     Emplace(Uint32 index, const T& elem);
   INLINE_LIB bool     AdjustSize();
+  INLINE_LIB void     Clear();
+  INLINE_LIB void     RemoveLast();
   INLINE_LIB T&       operator[](Uint32 index);
   INLINE_LIB const T& operator[](Uint32 index) const;
   INLINE_LIB Uint32   Capacity() const;
@@ -46,8 +81,14 @@ public:
   INLINE_LIB bool     Contains(const T& other) const;
   INLINE_LIB bool     Contains(std::function<bool(const T&)>) const;
   INLINE_LIB bool     IsEmpty() const;
+  INLINE_LIB bool     IsInline() const;
   INLINE_LIB Uint32   ElemSize() const;
 
+  template <typename... Args>
+  INLINE_LIB T& EmplaceBack(Args&&... args);
+
+  INLINE_LIB const Allocator& GetAllocator() const;
+
 public:
   INLINE_LIB T*       begin();
   INLINE_LIB const T* begin() const;
@@ -55,79 +96,145 @@ public:
   INLINE_LIB const T* end() const;
 
 private:
-  T*     data;
-  Uint32 count;
-  Uint32 size;
+  INLINE_LIB T*   InlineData();
+  INLINE_LIB void Grow();
+  INLINE_LIB void Destroy(Uint32 from, Uint32 to);
+  INLINE_LIB void Release();
+  INLINE_LIB void Take(Vector& other);
+
+private:
+  T*                                                  data;
+  Uint32                                              count;
+  Uint32                                              size;
+  [[no_unique_address]] Allocator                     allocator;
+  [[no_unique_address]] InlineStorage<T, InlineCount> storage;
 };
 
-template <typename T>
-INLINE_LIB Vector<T>::Vector(Uint32 initCount)
-    : size(initCount), count(initCount), data((T*)malloc(sizeof(T) * initCount))
+template <typename T, typename Allocator, Uint32 InlineCount>
+INLINE_LIB Vector<T, Allocator, InlineCount>::Vector()
+    : data(InlineData()), count(0), size(InlineCount), allocator()
 {
 }
 
-template <typename T>
-Vector<T>::Vector(std::initializer_list<T> init)
+template <typename T, typename Allocator, Uint32 InlineCount>
+INLINE_LIB Vector<T, Allocator, InlineCount>::Vector(const Allocator& allocator)
+    : data(InlineData()), count(0), size(InlineCount), allocator(allocator)
 {
+}
+
+template <typename T, typename Allocator, Uint32 InlineCount>
+INLINE_LIB Vector<T, Allocator, InlineCount>::Vector(const Uint32 initCount, const Allocator& allocator)
+    : data(InlineData()), count(0), size(InlineCount), allocator(allocator)
+{
+  Reserve(initCount);
+  for (; count < initCount; count++) {
+    new (data + count) T();
+  }
+}
+
+template <typename T, typename Allocator, Uint32 InlineCount>
+Vector<T, Allocator, InlineCount>::Vector(std::initializer_list<T> init, const Allocator& allocator)
+    : data(InlineData()), count(0), size(InlineCount), allocator(allocator)
+{
+  Reserve(static_cast<Uint32>(init.size()));
   for (const auto& elem : init) {
-    this->Insert(elem);
+    new (data + count++) T(elem);
   }
 }
-template <typename T>
-Vector<T>::Vector(Vector&& other)
+
+template <typename T, typename Allocator, Uint32 InlineCount>
+Vector<T, Allocator, InlineCount>::Vector(Vector&& other) noexcept
+    : data(InlineData()), count(0), size(InlineCount), allocator(std::move(other.allocator))
 {
-  *this = (Vector&&) other;
+  Take(other);
 }
 
-template <typename T>
-Vector<T>::Vector(const Vector& other)
+template <typename T, typename Allocator, Uint32 InlineCount>
+Vector<T, Allocator, InlineCount>::Vector(const Vector& other)
+    : data(InlineData()), count(0), size(InlineCount), allocator(other.allocator)
 {
-  *this = other;
+  Self = other;
 }
 
-template <typename T>
-Vector<T>& Vector<T>::operator=(Vector&& other)
+template <typename T, typename Allocator, Uint32 InlineCount>
+Vector<T, Allocator, InlineCount>::~Vector()
 {
-  *this = other;
-  delete &other;
-  return *this;
+  Release();
 }
 
-template <typename T>
-Vector<T>& Vector<T>::operator=(const Vector& other)
+template <typename T, typename Allocator, Uint32 InlineCount>
+Vector<T, Allocator, InlineCount>& Vector<T, Allocator, InlineCount>::operator=(Vector&& other) noexcept
 {
-  const auto byteSize = other.Count() * sizeof(T);
-  size = other.size;
-  count = other.count;
-  data = (T*)malloc(byteSize);
-  memcpy(data, other.data, byteSize);
-  return *this;
+  if (this != &other) {
+    Release();
+    allocator = std::move(other.allocator);
+    Take(other);
+  }
+  return Self;
 }
 
-template <typename T>
-Vector<T>& Vector<T>::operator=(std::vector<T> other)
+template <typename T, typename Allocator, Uint32 InlineCount>
+Vector<T, Allocator, InlineCount>& Vector<T, Allocator, InlineCount>::operator=(const Vector& other)
 {
-  data = (T*)malloc(sizeof(T) * other.size());
-  count = other.size();
-  size = other.capacity();
-  memcpy(data, other.data(), sizeof(T) * other.size());
-  return *this;
+  if (this == &other) {
+    return Self;
+  }
+  Clear();
+  Reserve(other.count);
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    if (other.count > 0) {
+      memcpy(data, other.data, sizeof(T) * other.count);
+    }
+    count = other.count;
+  }
+  else {
+    for (; count < other.count; count++) {
+      new (data + count) T(other.data[count]);
+    }
+  }
+  return Self;
 }
 
-template <typename T>
-INLINE_LIB bool Vector<T>::Insert(const T& element)
+template <typename T, typename Allocator, Uint32 InlineCount>
+Vector<T, Allocator, InlineCount>& Vector<T, Allocator, InlineCount>::operator=(const std::vector<T>& other)
 {
-  if (count >= size) {
-    const Uint32 newCapacity = size * 1.62;
-    Resize(newCapacity + (16 - (newCapacity % 16)));
+  Clear();
+  Reserve(static_cast<Uint32>(other.size()));
+  for (const T& elem : other) {
+    new (data + count++) T(elem);
   }
-  data[count] = element;
-  count++;
+  return Self;
+}
+
+template <typename T, typename Allocator, Uint32 InlineCount>
+INLINE_LIB bool Vector<T, Allocator, InlineCount>::Insert(const T& element)
+{
+  EmplaceBack(element);
   return true;
 }
 
-template <typename T>
-INLINE_LIB bool Vector<T>::At(Uint32 index, T* elem) const
+template <typename T, typename Allocator, Uint32 InlineCount>
+INLINE_LIB bool Vector<T, Allocator, InlineCount>::Insert(T&& element)
+{
+  EmplaceBack(std::move(element));
+  return true;
+}
+
+template <typename T, typename Allocator, Uint32 InlineCount>
+template <typename... Args>
+T& Vector<T, Allocator, InlineCount>::EmplaceBack(Args&&... args)
+{
+  if (count >= size) {
+    // The arguments may refer into the buffer about to be released, so build the element before growing.
+    T value(std::forward<Args>(args)...);
+    Grow();
+    return *new (data + count++) T(std::move(value));
+  }
+  return *new (data + count++) T(std::forward<Args>(args)...);
+}
+
+template <typename T, typename Allocator, Uint32 InlineCount>
+INLINE_LIB bool Vector<T, Allocator, InlineCount>::At(Uint32 index, T* elem) const
 {
   if (index >= count) {
     return false;
@@ -137,8 +244,8 @@ INLINE_LIB bool Vector<T>::At(Uint32 index, T* elem) const
   return true;
 }
 
-template <typename T>
-bool Vector<T>::At(Uint32 index, T** elem) const
+template <typename T, typename Allocator, Uint32 InlineCount>
+bool Vector<T, Allocator, InlineCount>::At(Uint32 index, T** elem) const
 {
   if (index >= count) {
     return false;
@@ -148,8 +255,8 @@ bool Vector<T>::At(Uint32 index, T** elem) const
   return true;
 }
 
-template <typename T>
-bool Vector<T>::Emplace(Uint32 index, const T& elem)
+template <typename T, typename Allocator, Uint32 InlineCount>
+bool Vector<T, Allocator, InlineCount>::Emplace(Uint32 index, const T& elem)
 {
   if (index >= count) {
     return false;
@@ -158,62 +265,81 @@ bool Vector<T>::Emplace(Uint32 index, const T& elem)
   return true;
 }
 
-template <typename T>
-bool Vector<T>::AdjustSize()
+template <typename T, typename Allocator, Uint32 InlineCount>
+bool Vector<T, Allocator, InlineCount>::AdjustSize()
 {
+  static_assert(std::is_trivially_copyable_v<T>, "AdjustSize leaves elements unconstructed");
   return Resize(count);
 }
 
-template <typename T>
-T& Vector<T>::operator[](Uint32 index)
+template <typename T, typename Allocator, Uint32 InlineCount>
+void Vector<T, Allocator, InlineCount>::Clear()
+{
+  Destroy(0, count);
+  count = 0;
+}
+
+template <typename T, typename Allocator, Uint32 InlineCount>
+void Vector<T, Allocator, InlineCount>::RemoveLast()
+{
+  if (count > 0) {
+    Destroy(count - 1, count);
+    count--;
+  }
+}
+
+template <typename T, typename Allocator, Uint32 InlineCount>
+T& Vector<T, Allocator, InlineCount>::operator[](Uint32 index)
 {
   return data[index];
 }
 
-template <typename T>
-const T& Vector<T>::operator[](Uint32 index) const
+template <typename T, typename Allocator, Uint32 InlineCount>
+const T& Vector<T, Allocator, InlineCount>::operator[](Uint32 index) const
 {
   return data[index];
 }
 
-template <typename T>
-Uint32 Vector<T>::Capacity() const
+template <typename T, typename Allocator, Uint32 InlineCount>
+Uint32 Vector<T, Allocator, InlineCount>::Capacity() const
 {
   return size;
 }
 
-template <typename T>
-Uint32 Vector<T>::Count() const
+template <typename T, typename Allocator, Uint32 InlineCount>
+Uint32 Vector<T, Allocator, InlineCount>::Count() const
 {
   return count;
 }
 
-template <typename T>
-void Vector<T>::OverrideCount(Uint32 newSize)
+template <typename T, typename Allocator, Uint32 InlineCount>
+void Vector<T, Allocator, InlineCount>::OverrideCount(Uint32 newSize)
 {
+  static_assert(std::is_trivially_copyable_v<T>, "OverrideCount neither constructs nor destroys elements");
   count = newSize;
 }
 
-template <typename T>
-Uint32& Vector<T>::CountMut()
+template <typename T, typename Allocator, Uint32 InlineCount>
+Uint32& Vector<T, Allocator, InlineCount>::CountMut()
 {
+  static_assert(std::is_trivially_copyable_v<T>, "CountMut neither constructs nor destroys elements");
   return count;
 }
 
-template <typename T>
-T* Vector<T>::Data()
+template <typename T, typename Allocator, Uint32 InlineCount>
+T* Vector<T, Allocator, InlineCount>::Data()
 {
   return data;
 }
 
-template <typename T>
-const T* Vector<T>::Data() const
+template <typename T, typename Allocator, Uint32 InlineCount>
+const T* Vector<T, Allocator, InlineCount>::Data() const
 {
   return data;
 }
 
-template <typename T>
-bool Vector<T>::Contains(const T& other) const
+template <typename T, typename Allocator, Uint32 InlineCount>
+bool Vector<T, Allocator, InlineCount>::Contains(const T& other) const
 {
   for (Uint32 i = 0; i < count; i++) {
     if (data[i] == other) {
@@ -223,8 +349,8 @@ bool Vector<T>::Contains(const T& other) const
   return false;
 }
 
-template <typename T>
-bool Vector<T>::Contains(std::function<bool(const T&)> found) const
+template <typename T, typename Allocator, Uint32 InlineCount>
+bool Vector<T, Allocator, InlineCount>::Contains(std::function<bool(const T&)> found) const
 {
   for (Uint32 i = 0; i < count; i++) {
     if (found(data[i])) {
@@ -234,62 +360,164 @@ bool Vector<T>::Contains(std::function<bool(const T&)> found) const
   return false;
 }
 
-template <typename T>
-bool Vector<T>::IsEmpty() const
+template <typename T, typename Allocator, Uint32 InlineCount>
+bool Vector<T, Allocator, InlineCount>::IsEmpty() const
 {
   return count <= 0;
 }
 
-template <typename T>
-Uint32 Vector<T>::ElemSize() const
+template <typename T, typename Allocator, Uint32 InlineCount>
+bool Vector<T, Allocator, InlineCount>::IsInline() const
+{
+  return data == storage.Data();
+}
+
+template <typename T, typename Allocator, Uint32 InlineCount>
+Uint32 Vector<T, Allocator, InlineCount>::ElemSize() const
 {
   return sizeof(T);
 }
 
-template <typename T>
-T* Vector<T>::begin()
+template <typename T, typename Allocator, Uint32 InlineCount>
+const Allocator& Vector<T, Allocator, InlineCount>::GetAllocator() const
+{
+  return allocator;
+}
+
+template <typename T, typename Allocator, Uint32 InlineCount>
+T* Vector<T, Allocator, InlineCount>::begin()
 {
   return data;
 }
 
-template <typename T>
-const T* Vector<T>::begin() const
+template <typename T, typename Allocator, Uint32 InlineCount>
+const T* Vector<T, Allocator, InlineCount>::begin() const
 {
   return data;
 }
 
-template <typename T>
-T* Vector<T>::end()
+template <typename T, typename Allocator, Uint32 InlineCount>
+T* Vector<T, Allocator, InlineCount>::end()
 {
   return data + count;
 }
 
-template <typename T>
-const T* Vector<T>::end() const
+template <typename T, typename Allocator, Uint32 InlineCount>
+const T* Vector<T, Allocator, InlineCount>::end() const
 {
   return data + count;
 }
 
-template <typename T>
-INLINE_LIB bool Vector<T>::Resize(const Uint32 newSize)
+// Sets the capacity to exactly newSize, but never below InlineCount, relocating every element into a new buffer.
+// Shrinking back to InlineCount returns to the inline storage.
+template <typename T, typename Allocator, Uint32 InlineCount>
+INLINE_LIB bool Vector<T, Allocator, InlineCount>::Resize(Uint32 newSize)
 {
   if (newSize < count) {
     return false;
   }
+  newSize = std::max(newSize, InlineCount);
   if (newSize == size) {
     return true;
   }
 
-  T* oldData = data;
-  T* newData = (T*)malloc(sizeof(T) * newSize);
-  memcpy(newData, oldData, sizeof(T) * count);
-  free(oldData);
+  // CountMut callers may have raised the count past the capacity before calling AdjustSize; only what the old buffer
+  // holds is moved over.
+  const Uint32 relocated = std::min(count, size);
+  T*           newData = newSize == InlineCount ? InlineData()
+                                                : static_cast<T*>(allocator.Allocate(sizeof(T) * newSize, alignof(T)));
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    if (relocated > 0) {
+      memcpy(newData, data, sizeof(T) * relocated);
+    }
+  }
+  else {
+    for (Uint32 i = 0; i < relocated; i++) {
+      new (newData + i) T(std::move(data[i]));
+      data[i].~T();
+    }
+  }
+  if (!IsInline()) {
+    allocator.Deallocate(data, sizeof(T) * size, alignof(T));
+  }
 
   size = newSize;
   data = newData;
   return true;
 }
 
+template <typename T, typename Allocator, Uint32 InlineCount>
+INLINE_LIB bool Vector<T, Allocator, InlineCount>::Reserve(const Uint32 newCapacity)
+{
+  return newCapacity <= size || Resize(newCapacity);
+}
+
+template <typename T, typename Allocator, Uint32 InlineCount>
+T* Vector<T, Allocator, InlineCount>::InlineData()
+{
+  return storage.Data();
+}
+
+template <typename T, typename Allocator, Uint32 InlineCount>
+void Vector<T, Allocator, InlineCount>::Grow()
+{
+  const Uint32 newCapacity = size * 1.62;
+  Resize(newCapacity + (16 - (newCapacity % 16)));
+}
+
+template <typename T, typename Allocator, Uint32 InlineCount>
+void Vector<T, Allocator, InlineCount>::Destroy(const Uint32 from, const Uint32 to)
+{
+  if constexpr (!std::is_trivially_destructible_v<T>) {
+    for (Uint32 i = from; i < to; i++) {
+      data[i].~T();
+    }
+  }
+}
+
+template <typename T, typename Allocator, Uint32 InlineCount>
+void Vector<T, Allocator, InlineCount>::Release()
+{
+  Destroy(0, count);
+  if (!IsInline()) {
+    allocator.Deallocate(data, sizeof(T) * size, alignof(T));
+  }
+  data = InlineData();
+  count = 0;
+  size = InlineCount;
+}
+
+// Moves other's elements into this, which must be empty and inline. Heap buffers are stolen; inline elements are
+// moved one by one. Without inline storage, an inline Vector is one that never allocated and has nothing to move.
+template <typename T, typename Allocator, Uint32 InlineCount>
+void Vector<T, Allocator, InlineCount>::Take(Vector& other)
+{
+  if (!other.IsInline()) {
+    data = other.data;
+    size = other.size;
+    count = other.count;
+    other.data = other.InlineData();
+    other.size = InlineCount;
+    other.count = 0;
+    return;
+  }
+
+  if constexpr (InlineCount > 0) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      if (other.count > 0) {
+        memcpy(data, other.data, sizeof(T) * other.count);
+      }
+      count = other.count;
+    }
+    else {
+      for (; count < other.count; count++) {
+        new (data + count) T(std::move(other.data[count]));
+      }
+    }
+    other.Clear();
+  }
+}
+
 }  // namespace NycaTech
 
 #endif  // VECTOR_H
@@ -0,0 +1,139 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#include "mesh_file.h"
+
+#include "lib/assert.h"
+#include "lib/mapped_file.h"
+
+namespace NycaTech {
+
+static Uint64 AlignOffset(Uint64 offset)
+{
+  return (offset + MeshFile::Alignment - 1) & ~static_cast<Uint64>(MeshFile::Alignment - 1);
+}
+
+bool MeshFile::Write(const char*         path,
+                     Span<const Float32> positions,
+                     Span<const Uint32>  indices,
+                     Span<const MeshLod> lods)
+{
+  if (positions.size() % 3 != 0 || positions.size() / 3 > UINT32_MAX || indices.size() > UINT32_MAX || lods.empty()
+      || lods.size() > UINT32_MAX) {
+    ErrorMessage = "mesh streams cannot be cooked";
+    return false;
+  }
+
+  Header header{};
+  header.magic = Magic;
+  header.version = Version;
+  header.vertexCount = static_cast<Uint32>(positions.size() / 3);
+  header.indexCount = static_cast<Uint32>(indices.size());
+  header.vertexStride = sizeof(Float32) * 3;
+  header.indexSize = sizeof(Uint32);
+  header.positionsOffset = AlignOffset(sizeof(Header));
+  header.indicesOffset = AlignOffset(header.positionsOffset + positions.size_bytes());
+  header.lodCount = static_cast<Uint32>(lods.size());
+  header.lodSize = sizeof(MeshLod);
+  header.lodsOffset = AlignOffset(header.indicesOffset + indices.size_bytes());
+  header.fileSize = header.lodsOffset + lods.size_bytes();
+
+  Math::Vec3 lower;
+  Math::Vec3 upper;
+  Math::Bounds(positions.data(), header.vertexCount, lower, upper);
+  memcpy(header.lower, &lower, sizeof(header.lower));
+  memcpy(header.upper, &upper, sizeof(header.upper));
+
+  StreamWriter out(path, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    ErrorMessage = "unable to open mesh for writing";
+    return false;
+  }
+
+  static constexpr char zeros[Alignment] = {};
+  out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+  out.write(zeros, static_cast<std::streamsize>(header.positionsOffset - sizeof(Header)));
+  out.write(reinterpret_cast<const char*>(positions.data()), static_cast<std::streamsize>(positions.size_bytes()));
+  out.write(zeros,
+            static_cast<std::streamsize>(header.indicesOffset - header.positionsOffset - positions.size_bytes()));
+  out.write(reinterpret_cast<const char*>(indices.data()), static_cast<std::streamsize>(indices.size_bytes()));
+  out.write(zeros, static_cast<std::streamsize>(header.lodsOffset - header.indicesOffset - indices.size_bytes()));
+  out.write(reinterpret_cast<const char*>(lods.data()), static_cast<std::streamsize>(lods.size_bytes()));
+  if (!out.good()) {
+    ErrorMessage = "unable to write mesh";
+    return false;
+  }
+  return true;
+}
+
+MappedFile* MeshFile::Open(const char* path)
+{
+  MappedFile* file = MappedFile::Open(path, MappedFile::Mode::Private);
+  if (!file) {
+    ErrorMessage = "unable to map mesh";
+    return nullptr;
+  }
+
+  const Uint64  size = file->Size();
+  const auto    inBounds = [size](Uint64 offset, Uint64 length) { return offset <= size && length <= size - offset; };
+  const Header& header = *reinterpret_cast<const Header*>(file->Data());
+  if (size < sizeof(Header) || header.magic != Magic || header.version != Version || header.fileSize != size
+      || header.vertexStride != sizeof(Float32) * 3 || header.indexSize != sizeof(Uint32)
+      || header.lodSize != sizeof(MeshLod) || header.lodCount == 0 || header.positionsOffset % Alignment != 0
+      || header.indicesOffset % Alignment != 0 || header.lodsOffset % Alignment != 0
+      || !inBounds(header.positionsOffset, Uint64(header.vertexStride) * header.vertexCount)
+      || !inBounds(header.indicesOffset, Uint64(header.indexSize) * header.indexCount)
+      || !inBounds(header.lodsOffset, Uint64(header.lodSize) * header.lodCount)) {
+    ErrorMessage = "mesh header is invalid or from another version";
+    delete file;
+    return nullptr;
+  }
+
+  // Out-of-range indices, or LODs past the index stream, would read past the buffers on the GPU, so this is the one
+  // pass over the data.
+  for (const MeshLod& lod: Lods(*file)) {
+    if (lod.indexCount % 3 != 0 || lod.firstIndex > header.indexCount
+        || lod.indexCount > header.indexCount - lod.firstIndex) {
+      ErrorMessage = "mesh LOD refers to indices that do not exist";
+      delete file;
+      return nullptr;
+    }
+  }
+  const Span<const Uint32> indices = Indices(*file);
+  for (const Uint32 index: indices) {
+    if (index >= header.vertexCount) {
+      ErrorMessage = "mesh index refers to a vertex that does not exist";
+      delete file;
+      return nullptr;
+    }
+  }
+  return file;
+}
+
+Span<Float32> MeshFile::Positions(MappedFile& file)
+{
+  const Header& header = *reinterpret_cast<const Header*>(file.Data());
+  return { reinterpret_cast<Float32*>(file.Data() + header.positionsOffset), Uint64(header.vertexCount) * 3 };
+}
+
+Span<const Uint32> MeshFile::Indices(const MappedFile& file)
+{
+  const Header& header = *reinterpret_cast<const Header*>(file.Data());
+  return { reinterpret_cast<const Uint32*>(file.Data() + header.indicesOffset), header.indexCount };
+}
+
+Span<const MeshLod> MeshFile::Lods(const MappedFile& file)
+{
+  const Header& header = *reinterpret_cast<const Header*>(file.Data());
+  return { reinterpret_cast<const MeshLod*>(file.Data() + header.lodsOffset), header.lodCount };
+}
+
+void MeshFile::Bounds(const MappedFile& file, Math::Vec3& lower, Math::Vec3& upper)
+{
+  const Header& header = *reinterpret_cast<const Header*>(file.Data());
+  lower = { header.lower[0], header.lower[1], header.lower[2] };
+  upper = { header.upper[0], header.upper[1], header.upper[2] };
+}
+
+}  // namespace NycaTech
@@ -0,0 +1,59 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef MESH_FILE_H
+#define MESH_FILE_H
+
+#include "lib/linear_algebra.h"
+#include "lib/types.h"
+#include "mesh_simplifier.h"
+
+namespace NycaTech {
+
+class MappedFile;
+
+// Cooked mesh: a versioned binary image of a model's position and index streams, its bounds and its LOD table, written
+// offline by NycaTechMeshCook. The index stream holds every LOD back to back. Each array starts on a 64 byte boundary,
+// so loading maps the file and hands the mapped pages to the renderer as they are; nothing is parsed or copied on the
+// way. The mapping is private, so positions can be transformed in place without touching the file.
+class MeshFile final {
+public:
+  static bool        Write(const char*         path,
+                           Span<const Float32> positions,
+                           Span<const Uint32>  indices,
+                           Span<const MeshLod> lods);
+  static MappedFile* Open(const char* path);
+
+  // Views into a mapping returned by Open.
+  static Span<Float32>       Positions(MappedFile& file);
+  static Span<const Uint32>  Indices(const MappedFile& file);
+  static Span<const MeshLod> Lods(const MappedFile& file);
+  static void                Bounds(const MappedFile& file, Math::Vec3& lower, Math::Vec3& upper);
+
+  static constexpr Uint32 Magic = 0x534D594E;  // "NYMS"
+  static constexpr Uint32 Version = 2;
+  static constexpr Uint32 Alignment = 64;
+
+private:
+  struct Header {
+    Uint32  magic;
+    Uint32  version;
+    Uint64  fileSize;
+    Uint32  vertexCount;
+    Uint32  indexCount;
+    Uint32  vertexStride;
+    Uint32  indexSize;
+    Float32 lower[3];
+    Float32 upper[3];
+    Uint64  positionsOffset;
+    Uint64  indicesOffset;
+    Uint32  lodCount;
+    Uint32  lodSize;
+    Uint64  lodsOffset;
+  };
+};
+
+}  // namespace NycaTech
+
+#endif  // MESH_FILE_H
@@ -0,0 +1,204 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+
+namespace NycaTech {
+
+static constexpr Uint32 None = UINT32_MAX;
+
+MeshOptimizer::Report MeshOptimizer::Optimize(Vector<Float32>& positions, Vector<Uint32>& indices, Uint32 cacheSize)
+{
+  Report report{};
+  report.verticesBefore = positions.Count() / 3;
+  report.trianglesBefore = indices.Count() / 3;
+  report.acmrBefore = Acmr(indices, report.verticesBefore, cacheSize);
+
+  // Tipsify can lose to the input order around hub vertices shared by thousands of triangles, so the better of the
+  // two orders is kept.
+  Weld(positions, indices);
+  Vector<Uint32> welded(indices);
+  OptimizeVertexCache(indices, report.verticesBefore, cacheSize);
+  if (Acmr(indices, report.verticesBefore, cacheSize) > Acmr(welded, report.verticesBefore, cacheSize)) {
+    indices = std::move(welded);
+  }
+  OptimizeVertexFetch(positions, indices);
+
+  report.verticesAfter = positions.Count() / 3;
+  report.trianglesAfter = indices.Count() / 3;
+  report.acmrAfter = Acmr(indices, report.verticesAfter, cacheSize);
+  return report;
+}
+
+Uint32 MeshOptimizer::Weld(const Vector<Float32>& positions, Vector<Uint32>& indices)
+{
+  struct Key {
+    Uint32 bits[3];
+    Uint32 vertex;
+
+    bool operator<(const Key& other) const
+    {
+      return std::tie(bits[0], bits[1], bits[2], vertex)
+             < std::tie(other.bits[0], other.bits[1], other.bits[2], other.vertex);
+    }
+  };
+
+  // Sorting by position bits puts equal positions next to each other, lowest vertex first.
+  const Uint32 vertexCount = positions.Count() / 3;
+  Vector<Key>  keys(vertexCount);
+  for (Uint32 v = 0; v < vertexCount; v++) {
+    for (Uint32 axis = 0; axis < 3; axis++) {
+      const Float32 value = positions[v * 3 + axis] + 0.0f;  // -0 becomes +0
+      memcpy(&keys[v].bits[axis], &value, sizeof(Uint32));
+    }
+    keys[v].vertex = v;
+  }
+  std::sort(keys.begin(), keys.end());
+
+  Vector<Uint32> canonical(vertexCount);
+  Uint32         merged = 0;
+  for (Uint32 i = 0; i < vertexCount; i++) {
+    const bool same = i > 0 && memcmp(keys[i].bits, keys[i - 1].bits, sizeof(Key::bits)) == 0;
+    canonical[keys[i].vertex] = same ? canonical[keys[i - 1].vertex] : keys[i].vertex;
+    merged += same ? 1 : 0;
+  }
+
+  Uint32 kept = 0;
+  for (Uint32 i = 0; i + 2 < indices.Count(); i += 3) {
+    const Uint32 a = canonical[indices[i]];
+    const Uint32 b = canonical[indices[i + 1]];
+    const Uint32 c = canonical[indices[i + 2]];
+    if (a != b && b != c && a != c) {
+      indices[kept++] = a;
+      indices[kept++] = b;
+      indices[kept++] = c;
+    }
+  }
+  indices.OverrideCount(kept);
+  return merged;
+}
+
+// Tipsify: fan out from one vertex at a time, emitting all of its remaining triangles, then continue from whichever
+// vertex just emitted will still be in the cache after its own remaining triangles are emitted. When none qualifies
+// the most recently referenced vertex with triangles left is taken, then the next such vertex in input order.
+void MeshOptimizer::OptimizeVertexCache(Vector<Uint32>& indices, Uint32 vertexCount, Uint32 cacheSize)
+{
+  const Uint32 triangleCount = indices.Count() / 3;
+  if (triangleCount == 0) {
+    return;
+  }
+
+  // Triangles around each vertex, packed into one list.
+  Vector<Uint32> offsets(vertexCount + 1);
+  for (Uint32 i = 0; i < triangleCount * 3; i++) {
+    offsets[indices[i] + 1]++;
+  }
+  for (Uint32 v = 0; v < vertexCount; v++) {
+    offsets[v + 1] += offsets[v];
+  }
+  Vector<Uint32> adjacency(triangleCount * 3);
+  Vector<Uint32> live(vertexCount);
+  for (Uint32 i = 0; i < triangleCount * 3; i++) {
+    const Uint32 v = indices[i];
+    adjacency[offsets[v] + live[v]++] = i / 3;
+  }
+
+  Vector<Uint32> stamps(vertexCount);
+  Vector<Uint8>  emitted(triangleCount);
+  Vector<Uint32> deadEnds;
+  Vector<Uint32> candidates;
+  Vector<Uint32> output;
+  output.Reserve(triangleCount * 3);
+  Uint32 time = cacheSize + 1;
+  Uint32 cursor = 0;
+  Uint32 fanning = indices[0];
+  while (fanning != None) {
+    candidates.Clear();
+    for (Uint32 k = offsets[fanning]; k < offsets[fanning + 1]; k++) {
+      const Uint32 triangle = adjacency[k];
+      if (emitted[triangle]) {
+        continue;
+      }
+      for (Uint32 corner = 0; corner < 3; corner++) {
+        const Uint32 v = indices[triangle * 3 + corner];
+        output.Insert(v);
+        deadEnds.Insert(v);
+        candidates.Insert(v);
+        live[v]--;
+        if (time - stamps[v] > cacheSize) {
+          stamps[v] = time++;
+        }
+      }
+      emitted[triangle] = 1;
+    }
+
+    fanning = None;
+    Int64 best = -1;
+    for (const Uint32 v: candidates) {
+      if (live[v] == 0) {
+        continue;
+      }
+      const Uint32 age = time - stamps[v];
+      const Int64  priority = age + 2 * live[v] <= cacheSize ? age : 0;
+      if (priority > best) {
+        best = priority;
+        fanning = v;
+      }
+    }
+    while (fanning == None && !deadEnds.IsEmpty()) {
+      const Uint32 v = deadEnds[deadEnds.Count() - 1];
+      deadEnds.RemoveLast();
+      fanning = live[v] > 0 ? v : None;
+    }
+    for (; fanning == None && cursor < vertexCount; cursor++) {
+      fanning = live[cursor] > 0 ? cursor : None;
+    }
+  }
+  indices = std::move(output);
+}
+
+void MeshOptimizer::OptimizeVertexFetch(Vector<Float32>& positions, Vector<Uint32>& indices)
+{
+  Vector<Uint32> remap(positions.Count() / 3);
+  std::fill(remap.begin(), remap.end(), None);
+  Vector<Float32> reordered;
+  reordered.Reserve(positions.Count());
+  Uint32 next = 0;
+  for (Uint32& index: indices) {
+    if (remap[index] == None) {
+      remap[index] = next++;
+      reordered.Insert(positions[index * 3]);
+      reordered.Insert(positions[index * 3 + 1]);
+      reordered.Insert(positions[index * 3 + 2]);
+    }
+    index = remap[index];
+  }
+  positions = std::move(reordered);
+}
+
+Float32 MeshOptimizer::Acmr(const Vector<Uint32>& indices, Uint32 vertexCount, Uint32 cacheSize)
+{
+  const Uint32 triangleCount = indices.Count() / 3;
+  if (triangleCount == 0) {
+    return 0.0f;
+  }
+
+  // A FIFO cache is a window over the sequence of misses: a vertex is cached while fewer than cacheSize misses have
+  // happened since its own.
+  Vector<Uint32> loaded(vertexCount);
+  Uint32         misses = 0;
+  for (Uint32 i = 0; i < triangleCount * 3; i++) {
+    const Uint32 v = indices[i];
+    if (loaded[v] == 0 || misses - loaded[v] + 1 > cacheSize) {
+      loaded[v] = ++misses;
+    }
+  }
+  return static_cast<Float32>(misses) / static_cast<Float32>(triangleCount);
+}
+
+}  // namespace NycaTech
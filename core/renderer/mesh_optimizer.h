@@ -0,0 +1,44 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include "lib/types.h"
+#include "lib/vector.h"
+
+namespace NycaTech {
+
+// Import-time passes over a triangle list of packed xyz positions. Optimize runs all three: Weld merges duplicate
+// vertices, OptimizeVertexCache reorders triangles for the GPU's post-transform cache with Tipsify (Sander, Nehab and
+// Barczak, 2007), and OptimizeVertexFetch renumbers vertices in first-use order so fetches walk memory forwards.
+class MeshOptimizer final {
+public:
+  struct Report {
+    Uint32  verticesBefore;
+    Uint32  verticesAfter;
+    Uint32  trianglesBefore;
+    Uint32  trianglesAfter;
+    Float32 acmrBefore;
+    Float32 acmrAfter;
+  };
+
+  static Report Optimize(Vector<Float32>& positions, Vector<Uint32>& indices, Uint32 cacheSize = CacheSize);
+
+  // Points every index at the first of the bitwise equal positions (-0 and +0 count as equal) and drops triangles
+  // this leaves with a repeated corner. Returns how many vertices were merged; OptimizeVertexFetch drops them.
+  static Uint32 Weld(const Vector<Float32>& positions, Vector<Uint32>& indices);
+  static void   OptimizeVertexCache(Vector<Uint32>& indices, Uint32 vertexCount, Uint32 cacheSize = CacheSize);
+  static void   OptimizeVertexFetch(Vector<Float32>& positions, Vector<Uint32>& indices);
+
+  // Average cache miss ratio: vertex shader invocations per triangle under a FIFO cache of `cacheSize` entries.
+  // 0.5 is the ideal for a large regular grid and 3 means no reuse at all.
+  static Float32 Acmr(const Vector<Uint32>& indices, Uint32 vertexCount, Uint32 cacheSize = CacheSize);
+
+  static constexpr Uint32 CacheSize = 16;
+};
+
+}  // namespace NycaTech
+
+#endif  // MESH_OPTIMIZER_H
@@ -0,0 +1,387 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#include "mesh_simplifier.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <utility>
+
+#include "lib/linear_algebra.h"
+#include "lib/small_vector.h"
+#include "mesh_optimizer.h"
+#include "thread_pool.h"
+
+namespace NycaTech {
+
+// Symmetric 4x4 matrix of the summed plane equations and the summed weights of the planes. Error divides by the
+// latter, so it is the weighted mean squared distance to the planes: a length squared whatever the weights are
+// measured in, which keeps errors relative to the bounds the same at any model scale. Sums run in double since the
+// terms of large flat regions nearly cancel.
+struct Quadric {
+  double xx, xy, xz, xw;
+  double yy, yz, yw;
+  double zz, zw;
+  double ww;
+  double weight;
+};
+
+static void AddPlane(Quadric& q, const Math::Vec3& normal, Float32 distance, double weight)
+{
+  const double a = normal.x;
+  const double b = normal.y;
+  const double c = normal.z;
+  const double d = distance;
+  q.xx += weight * a * a;
+  q.xy += weight * a * b;
+  q.xz += weight * a * c;
+  q.xw += weight * a * d;
+  q.yy += weight * b * b;
+  q.yz += weight * b * c;
+  q.yw += weight * b * d;
+  q.zz += weight * c * c;
+  q.zw += weight * c * d;
+  q.ww += weight * d * d;
+  q.weight += weight;
+}
+
+static Quadric Sum(const Quadric& lhs, const Quadric& rhs)
+{
+  return { lhs.xx + rhs.xx, lhs.xy + rhs.xy, lhs.xz + rhs.xz, lhs.xw + rhs.xw, lhs.yy + rhs.yy, lhs.yz + rhs.yz,
+           lhs.yw + rhs.yw, lhs.zz + rhs.zz, lhs.zw + rhs.zw, lhs.ww + rhs.ww, lhs.weight + rhs.weight };
+}
+
+static double Error(const Quadric& q, const Math::Vec3& p)
+{
+  const double x = p.x;
+  const double y = p.y;
+  const double z = p.z;
+  const double error = q.xx * x * x + q.yy * y * y + q.zz * z * z
+                       + 2.0 * (q.xy * x * y + q.xz * x * z + q.yz * y * z + q.xw * x + q.yw * y + q.zw * z) + q.ww;
+  return q.weight > 0.0 ? std::max(error, 0.0) / q.weight : 0.0;
+}
+
+static Math::Vec3 Point(const Vector<Float32>& positions, Uint32 vertex)
+{
+  return { positions[vertex * 3], positions[vertex * 3 + 1], positions[vertex * 3 + 2] };
+}
+
+static Uint64 EdgeKey(Uint32 a, Uint32 b)
+{
+  return static_cast<Uint64>(std::min(a, b)) << 32 | std::max(a, b);
+}
+
+// Moving `from` onto `to` costs `cost`, the squared distance error it leaves.
+struct Collapse {
+  double cost;
+  Uint32 from;
+  Uint32 to;
+};
+
+// Sorts collapses by cost, cheapest first, with a radix sort over the bits of the cost as a Float32 in three passes of
+// 11 bits. Costs are never negative, so those bits order like the floats themselves.
+static void SortByCost(Vector<Collapse>& collapses, Vector<Collapse>& scratch)
+{
+  constexpr Uint32 DigitBits = 11;
+  constexpr Uint32 Digits = 1 << DigitBits;
+
+  scratch.Reserve(collapses.Count());
+  scratch.OverrideCount(collapses.Count());
+  for (Uint32 shift = 0; shift < 32; shift += DigitBits) {
+    const auto digit = [shift](const Collapse& collapse) {
+      return std::bit_cast<Uint32>(static_cast<Float32>(collapse.cost)) >> shift & (Digits - 1);
+    };
+    Uint32 offsets[Digits] = {};
+    for (const Collapse& collapse: collapses) {
+      offsets[digit(collapse)]++;
+    }
+    Uint32 total = 0;
+    for (Uint32& offset: offsets) {
+      total += std::exchange(offset, total);
+    }
+    for (const Collapse& collapse: collapses) {
+      scratch[offsets[digit(collapse)]++] = collapse;
+    }
+    std::swap(collapses, scratch);
+  }
+}
+
+static Vector<Quadric> BuildQuadrics(const Vector<Float32>& positions, const Vector<Uint32>& indices)
+{
+  struct Edge {
+    Uint64 key;
+    Uint32 triangle;
+
+    bool operator<(const Edge& other) const { return key < other.key; }
+  };
+
+  const Uint32    triangleCount = indices.Count() / 3;
+  Vector<Quadric> quadrics(positions.Count() / 3);
+  Vector<Edge>    edges;
+  edges.Reserve(triangleCount * 3);
+  for (Uint32 t = 0; t < triangleCount; t++) {
+    const Uint32*    corners = &indices[t * 3];
+    const Math::Vec3 p0 = Point(positions, corners[0]);
+    const Math::Vec3 normal = Math::Cross(Point(positions, corners[1]) - p0, Point(positions, corners[2]) - p0);
+    const Float32    area = Math::Length(normal) * 0.5f;
+    if (area > 0.0f) {
+      const Math::Vec3 unit = normal * (0.5f / area);
+      for (Uint32 corner = 0; corner < 3; corner++) {
+        AddPlane(quadrics[corners[corner]], unit, -Math::Dot(unit, p0), area);
+      }
+    }
+    for (Uint32 corner = 0; corner < 3; corner++) {
+      edges.Insert({ EdgeKey(corners[corner], corners[(corner + 1) % 3]), t });
+    }
+  }
+
+  // An edge only one triangle uses is a border. A plane through it, perpendicular to the triangle, keeps collapses
+  // from pulling the border inwards; it is weighted by the squared edge length to match the area-weighted faces.
+  std::sort(edges.begin(), edges.end());
+  for (Uint32 i = 0; i < edges.Count(); i++) {
+    const bool shared = (i > 0 && edges[i - 1].key == edges[i].key)
+                        || (i + 1 < edges.Count() && edges[i + 1].key == edges[i].key);
+    if (shared) {
+      continue;
+    }
+    const Uint32*    corners = &indices[edges[i].triangle * 3];
+    const auto       a = static_cast<Uint32>(edges[i].key >> 32);
+    const auto       b = static_cast<Uint32>(edges[i].key);
+    const Math::Vec3 pa = Point(positions, a);
+    const Math::Vec3 along = Point(positions, b) - pa;
+    const Math::Vec3 p0 = Point(positions, corners[0]);
+    const Math::Vec3 face = Math::Cross(Point(positions, corners[1]) - p0, Point(positions, corners[2]) - p0);
+    const Math::Vec3 normal = Math::Normalize(Math::Cross(along, face));
+    const double     weight = Math::Dot(along, along) * MeshSimplifier::BoundaryWeight;
+    AddPlane(quadrics[a], normal, -Math::Dot(normal, pa), weight);
+    AddPlane(quadrics[b], normal, -Math::Dot(normal, pa), weight);
+  }
+  return quadrics;
+}
+
+static double Diagonal(const Vector<Float32>& positions)
+{
+  Math::Vec3 lower;
+  Math::Vec3 upper;
+  Math::Bounds(positions.Data(), positions.Count() / 3, lower, upper);
+  return Math::Length(upper - lower);
+}
+
+// Collapses edges of `out` in place until it has at most `targetIndexCount` indices or the next collapse would cost
+// more than `maxCost`, folding each removed vertex's quadric into the one it moved onto. Returns the largest cost paid.
+static double CollapseEdges(const Vector<Float32>& positions,
+                            Vector<Quadric>&       quadrics,
+                            Uint32                 targetIndexCount,
+                            double                 maxCost,
+                            Vector<Uint32>&        out)
+{
+  ThreadPool&              pool = ThreadPool::Shared();
+  const Uint32             vertexCount = positions.Count() / 3;
+  const Uint32             chunkCount = vertexCount > 0 ? (vertexCount - 1) / MeshSimplifier::ScoreChunkSize + 1 : 1;
+  double                   reached = 0.0;
+  Vector<Uint32>           offsets(vertexCount + 1);
+  Vector<Uint32>           adjacency;
+  Vector<Uint32>           filled(vertexCount);
+  Vector<Vector<Collapse>> scored(chunkCount);
+  Vector<Collapse>         collapses;
+  Vector<Collapse>         scratch;
+  Vector<Uint32>           remap(vertexCount);
+  Vector<Uint8>            locked(vertexCount);
+  while (out.Count() > targetIndexCount) {
+    // Triangles around each vertex, packed into one list, as in MeshOptimizer::OptimizeVertexCache.
+    std::fill(offsets.begin(), offsets.end(), 0);
+    for (const Uint32 v: out) {
+      offsets[v + 1]++;
+    }
+    for (Uint32 v = 0; v < vertexCount; v++) {
+      offsets[v + 1] += offsets[v];
+    }
+    adjacency.Reserve(out.Count());
+    adjacency.OverrideCount(out.Count());
+    std::fill(filled.begin(), filled.end(), 0);
+    for (Uint32 i = 0; i < out.Count(); i++) {
+      const Uint32 v = out[i];
+      adjacency[offsets[v] + filled[v]++] = i / 3;
+    }
+
+    // Every edge is found once, from its lower end, among the corners of the triangles around that end; sorting them
+    // keeps vertices shared by thousands of triangles from costing the square of that. Each edge collapses towards
+    // whichever end leaves the smaller error. Chunks of vertices are scored across the shared pool; the last runs on
+    // the calling thread, so small meshes never leave it.
+    const auto score = [&](Uint32 chunk) {
+      const Uint32            begin = chunk * MeshSimplifier::ScoreChunkSize;
+      const Uint32            end = std::min(begin + MeshSimplifier::ScoreChunkSize, vertexCount);
+      Vector<Collapse>&       found = scored[chunk];
+      SmallVector<Uint32, 32> neighbours;
+      found.Clear();
+      for (Uint32 a = begin; a < end; a++) {
+        neighbours.Clear();
+        for (Uint32 k = offsets[a]; k < offsets[a + 1]; k++) {
+          for (Uint32 corner = 0; corner < 3; corner++) {
+            const Uint32 b = out[adjacency[k] * 3 + corner];
+            if (b > a) {
+              neighbours.Insert(b);
+            }
+          }
+        }
+        std::sort(neighbours.begin(), neighbours.end());
+        const Uint32* last = std::unique(neighbours.begin(), neighbours.end());
+        neighbours.OverrideCount(static_cast<Uint32>(last - neighbours.begin()));
+        for (const Uint32 b: neighbours) {
+          const Quadric q = Sum(quadrics[a], quadrics[b]);
+          const double  toA = Error(q, Point(positions, a));
+          const double  toB = Error(q, Point(positions, b));
+          if (std::min(toA, toB) <= maxCost) {
+            found.Insert(toB <= toA ? Collapse{ toB, a, b } : Collapse{ toA, b, a });
+          }
+        }
+      }
+    };
+    JobCounter remaining;
+    for (Uint32 chunk = 0; chunk + 1 < chunkCount; chunk++) {
+      pool.Submit([&score, chunk] { score(chunk); }, remaining);
+    }
+    score(chunkCount - 1);
+    pool.WaitFor(remaining);
+    Uint32 total = 0;
+    for (const Vector<Collapse>& found: scored) {
+      total += found.Count();
+    }
+    collapses.Reserve(total);
+    collapses.OverrideCount(0);
+    for (const Vector<Collapse>& found: scored) {
+      std::copy(found.begin(), found.end(), collapses.end());
+      collapses.OverrideCount(collapses.Count() + found.Count());
+    }
+    SortByCost(collapses, scratch);
+
+    // A collapse removes the triangles on its edge, which are counted so the pass stops right at the target. Once a
+    // vertex moves, the costs around it are stale, so its whole neighbourhood waits for the next pass. So does a
+    // vertex whose cheapest collapse flips a triangle, which bounds the flip checks of a pass by the mesh size.
+    const Uint32 wanted = out.Count() - targetIndexCount;
+    Uint32       removed = 0;
+    for (Uint32 v = 0; v < vertexCount; v++) {
+      remap[v] = v;
+    }
+    std::fill(locked.begin(), locked.end(), 0);
+    for (const Collapse& collapse: collapses) {
+      if (removed >= wanted) {
+        break;
+      }
+      if (locked[collapse.from] || locked[collapse.to]) {
+        continue;
+      }
+
+      const Math::Vec3 target = Point(positions, collapse.to);
+      bool             flips = false;
+      Uint32           shared = 0;
+      for (Uint32 k = offsets[collapse.from]; k < offsets[collapse.from + 1] && !flips; k++) {
+        const Uint32* corners = &out[adjacency[k] * 3];
+        if (corners[0] == collapse.to || corners[1] == collapse.to || corners[2] == collapse.to) {
+          shared++;
+          continue;
+        }
+        Math::Vec3 before[3];
+        Math::Vec3 after[3];
+        for (Uint32 corner = 0; corner < 3; corner++) {
+          before[corner] = Point(positions, corners[corner]);
+          after[corner] = corners[corner] == collapse.from ? target : before[corner];
+        }
+        const Math::Vec3 normalBefore = Math::Cross(before[1] - before[0], before[2] - before[0]);
+        const Math::Vec3 normalAfter = Math::Cross(after[1] - after[0], after[2] - after[0]);
+        flips = Math::Dot(normalBefore, normalAfter) <= 0.0f;
+      }
+      if (flips) {
+        locked[collapse.from] = 1;
+        continue;
+      }
+
+      remap[collapse.from] = collapse.to;
+      quadrics[collapse.to] = Sum(quadrics[collapse.to], quadrics[collapse.from]);
+      reached = std::max(reached, collapse.cost);
+      removed += shared * 3;
+      for (Uint32 k = offsets[collapse.from]; k < offsets[collapse.from + 1]; k++) {
+        const Uint32* corners = &out[adjacency[k] * 3];
+        locked[corners[0]] = locked[corners[1]] = locked[corners[2]] = 1;
+      }
+    }
+    if (removed == 0) {
+      break;
+    }
+
+    Uint32 kept = 0;
+    for (Uint32 i = 0; i < out.Count(); i += 3) {
+      const Uint32 a = remap[out[i]];
+      const Uint32 b = remap[out[i + 1]];
+      const Uint32 c = remap[out[i + 2]];
+      if (a != b && b != c && a != c) {
+        out[kept++] = a;
+        out[kept++] = b;
+        out[kept++] = c;
+      }
+    }
+    out.OverrideCount(kept);
+
+    // When one vertex's neighbourhood covers most of the mesh, every pass stalls on it like this one did.
+    if (removed < wanted / MeshSimplifier::MinPassProgress) {
+      break;
+    }
+  }
+  return reached;
+}
+
+Float32 MeshSimplifier::Simplify(const Vector<Float32>& positions,
+                                 const Vector<Uint32>&  indices,
+                                 Uint32                 targetIndexCount,
+                                 Float32                maxError,
+                                 Vector<Uint32>&        out)
+{
+  out = indices;
+  const double diagonal = Diagonal(positions);
+  if (diagonal <= 0.0 || out.Count() <= targetIndexCount) {
+    return 0.0f;
+  }
+
+  Vector<Quadric> quadrics = BuildQuadrics(positions, indices);
+  const double    maxCost = (maxError * diagonal) * (maxError * diagonal);
+  const double    reached = CollapseEdges(positions, quadrics, targetIndexCount, maxCost, out);
+  return static_cast<Float32>(std::sqrt(reached) / diagonal);
+}
+
+void MeshSimplifier::BuildLods(const Vector<Float32>& positions, Vector<Uint32>& indices, Vector<MeshLod>& lods)
+{
+  lods.Clear();
+  lods.Insert({ 0, indices.Count(), 0.0f, 0 });
+  const double diagonal = Diagonal(positions);
+  if (diagonal <= 0.0) {
+    return;
+  }
+
+  // Each level carries on from the one before with the quadrics it has accumulated, which still hold every plane of
+  // LOD 0. Errors stay measured against LOD 0 while the whole chain costs about one simplification of it.
+  Vector<Quadric> quadrics = BuildQuadrics(positions, indices);
+  Vector<Uint32>  simplified(indices);
+  const double    maxCost = (MaxLodError * diagonal) * (MaxLodError * diagonal);
+  double          reached = 0.0;
+  while (lods.Count() < MaxLods) {
+    const Uint32 target = simplified.Count() / 6 * 3;
+    if (target < MinLodTriangles * 3) {
+      break;
+    }
+    reached = std::max(reached, CollapseEdges(positions, quadrics, target, maxCost, simplified));
+    const MeshLod& previous = lods[lods.Count() - 1];
+    if (simplified.Count() > previous.indexCount - previous.indexCount / 8) {
+      break;
+    }
+    MeshOptimizer::OptimizeVertexCache(simplified, positions.Count() / 3);
+    lods.Insert({ indices.Count(), simplified.Count(), static_cast<Float32>(std::sqrt(reached) / diagonal), 0 });
+    indices.Reserve(indices.Count() + simplified.Count());
+    for (const Uint32 index: simplified) {
+      indices.Insert(index);
+    }
+  }
+}
+
+}  // namespace NycaTech
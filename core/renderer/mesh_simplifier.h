@@ -0,0 +1,54 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef MESH_SIMPLIFIER_H
+#define MESH_SIMPLIFIER_H
+
+#include "lib/types.h"
+#include "lib/vector.h"
+
+namespace NycaTech {
+
+// One level of detail: a range of a model's index buffer and its geometric error relative to the diagonal of the
+// model's bounds. Every level indexes the same vertices, so switching level only changes the draw call.
+struct MeshLod {
+  Uint32  firstIndex;
+  Uint32  indexCount;
+  Float32 error;
+  Uint32  reserved;
+};
+
+// Quadric error metric simplification (Garland and Heckbert, 1997) by edge collapse onto existing vertices, so the
+// result reuses the input's vertex buffer. Each vertex accumulates the planes of its triangles weighted by area, plus
+// planes perpendicular to its boundary edges so open borders stay put. Collapses run in passes: all edges are scored,
+// and the cheapest are applied as long as their neighbourhoods do not overlap and no triangle flips over.
+class MeshSimplifier final {
+public:
+  // Writes a simplified copy of `indices` with at most `targetIndexCount` indices to `out`, stopping early rather
+  // than exceeding `maxError`. Returns the error reached; errors are relative to the diagonal of the mesh's bounds.
+  static Float32 Simplify(const Vector<Float32>& positions,
+                          const Vector<Uint32>&  indices,
+                          Uint32                 targetIndexCount,
+                          Float32                maxError,
+                          Vector<Uint32>&        out);
+
+  // Treats all of `indices` as LOD 0 and appends coarser levels, each simplified on from the one before to about half
+  // its triangles, until a level would drop under MinLodTriangles, stop shrinking, or exceed MaxLodError. Levels are
+  // reordered for the vertex cache. `lods` receives every level including LOD 0.
+  static void BuildLods(const Vector<Float32>& positions, Vector<Uint32>& indices, Vector<MeshLod>& lods);
+
+  static constexpr Uint32  MaxLods = 8;
+  static constexpr Uint32  MinLodTriangles = 32;
+  static constexpr Float32 MaxLodError = 0.05f;
+  static constexpr Float32 BoundaryWeight = 10.0f;
+
+  // Vertices whose edges one job scores per pass.
+  static constexpr Uint32 ScoreChunkSize = 16 * 1024;
+  // Simplification gives up after a pass that removes less than 1 / MinPassProgress of what is left to remove.
+  static constexpr Uint32 MinPassProgress = 16;
+};
+
+}  // namespace NycaTech
+
+#endif  // MESH_SIMPLIFIER_H
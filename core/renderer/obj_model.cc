@@ -7,69 +7,149 @@
 
 #include <vulkan/vulkan.h>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
+#include "lib/mapped_file.h"
+#include "mesh_file.h"
+#include "mesh_optimizer.h"
+#include "obj_parser.h"
+#include "thread_pool.h"
+
 namespace NycaTech {
 
 ObjModel::ObjModel()
+    : mesh(nullptr), lod(0)
 {
 }
 
+ObjModel::~ObjModel()
+{
+  delete mesh;
+}
+
 bool ObjModel::Rotate(Float32 yaw, Float32 pitch, Float32 roll)
 {
-  const Float32 cosYaw = cos(yaw), sinYaw = sin(yaw);
-  const Float32 cosPitch = cos(pitch), sinPitch = sin(pitch);
-  const Float32 cosRoll = cos(roll), sinRoll = sin(roll);
+  return Apply(Math::Rotation(Math::FromEuler(yaw, pitch, roll)));
+}
 
-  for (Uint32 i = 0; i < vertices.Count(); i += 3) {
-    Float32 x = vertices[i + 0], y = vertices[i + 1], z = vertices[i + 2];
+bool ObjModel::Move(Float32 x, Float32 y, Float32 z)
+{
+  return Apply(Math::Translation({ x, y, z }));
+}
 
-    vertices[i + 0] = ((x * cosYaw) - (y * sinYaw)) + ((x * cosPitch) + (z * sinPitch));
-    vertices[i + 1] = ((x * sinYaw) + (y * cosYaw)) + ((y * cosRoll) - (z * sinRoll));
-    vertices[i + 2] = ((x * sinPitch) - (z * cosPitch)) + ((y * sinRoll) + (z * cosRoll));
-  }
+bool ObjModel::Scale(Float32 x, Float32 y, Float32 z)
+{
+  return Apply(Math::Scaling({ x, y, z }));
+}
 
-  return true;
+bool ObjModel::Bake(const Transform& transform)
+{
+  return Apply(Math::Compose(transform));
 }
 
-bool ObjModel::Move(Float32 x, Float32 y, Float32 z)
+bool ObjModel::Apply(const Math::Mat4& matrix)
 {
-  for (Uint32 i = 0; i < vertices.Count(); i += 3) {
-    vertices[i + 0] += x;
-    vertices[i + 1] += y;
-    vertices[i + 2] += z;
+  struct Box {
+    Math::Vec3 lower;
+    Math::Vec3 upper;
+  };
+
+  // Each chunk fits its own box while its positions are still in cache. The last chunk runs on the calling thread, so
+  // small meshes never leave it.
+  ThreadPool&         pool = ThreadPool::Shared();
+  JobCounter          remaining;
+  const Span<Float32> positions = Positions();
+  const auto          count = static_cast<Uint32>(positions.size() / 3);
+  const Uint32        chunkCount = count > 0 ? (count - 1) / TransformChunkSize + 1 : 1;
+  Vector<Box>         boxes(chunkCount);
+  const auto          transform = [&matrix, &boxes, data = positions.data(), count](Uint32 chunk) {
+    const Uint32 begin = chunk * TransformChunkSize;
+    const Uint32 length = std::min(TransformChunkSize, count - begin);
+    Float32*     points = data + static_cast<Uint64>(begin) * 3;
+    Math::TransformPoints(matrix, points, points, length);
+    Math::Bounds(points, length, boxes[chunk].lower, boxes[chunk].upper);
+  };
+  for (Uint32 chunk = 0; chunk + 1 < chunkCount; chunk++) {
+    pool.Submit([&transform, chunk] { transform(chunk); }, remaining);
+  }
+  transform(chunkCount - 1);
+  pool.WaitFor(remaining);
+
+  lower = boxes[0].lower;
+  upper = boxes[0].upper;
+  for (const Box& box: boxes) {
+    lower = { std::fmin(lower.x, box.lower.x), std::fmin(lower.y, box.lower.y), std::fmin(lower.z, box.lower.z) };
+    upper = { std::fmax(upper.x, box.upper.x), std::fmax(upper.y, box.upper.y), std::fmax(upper.z, box.upper.z) };
   }
   return true;
 }
 
-bool ObjModel::Scale(Float32 x, Float32 y, Float32 z)
+Span<Float32> ObjModel::Positions()
 {
-  for (Uint32 i = 0; i < vertices.Count(); i += 3) {
-    vertices[i + 0] *= x;
-    vertices[i + 1] *= y;
-    vertices[i + 2] *= z;
+  return mesh ? MeshFile::Positions(*mesh) : Span<Float32>(vertices.Data(), vertices.Count());
+}
+
+Span<const Uint32> ObjModel::Indices() const
+{
+  return mesh ? MeshFile::Indices(*mesh) : Span<const Uint32>(indices.Data(), indices.Count());
+}
+
+Span<const MeshLod> ObjModel::Lods() const
+{
+  return mesh ? MeshFile::Lods(*mesh) : Span<const MeshLod>(lods.Data(), lods.Count());
+}
+
+Uint32 ObjModel::SelectLod(const Math::Vec3& eye, Float32 projectionScale)
+{
+  // The renderer draws positions as they are, with any transform already baked in by Apply, which refits the bounds
+  // too. LOD errors are relative to their diagonal. The distance is to the near side of the bounding sphere, so
+  // nothing inside it gets closer than assumed.
+  const Span<const MeshLod> levels = Lods();
+  const Float32             diagonal = Math::Length(upper - lower);
+  const Math::Vec3          center = (lower + upper) * 0.5f;
+  const Float32             distance = std::max(Math::Length(center - eye) - diagonal * 0.5f, 1e-3f);
+  const auto pixels = [&](Uint32 level) { return levels[level].error * diagonal * projectionScale / distance; };
+
+  lod = std::min(lod, static_cast<Uint32>(levels.size()) - 1);
+  while (lod + 1 < levels.size() && pixels(lod + 1) <= LodPixelError * (1.0f - LodHysteresis)) {
+    lod++;
   }
-  return true;
+  while (lod > 0 && pixels(lod) > LodPixelError * (1.0f + LodHysteresis)) {
+    lod--;
+  }
+  return lod;
 }
 
-ObjModel* ObjModel::FromFile(const char* file_path)
+ObjModel* ObjModel::FromFile(const char* file_path, bool buildLods)
 {
-  tinyobj::ObjReader reader;
-  ObjModel*          model = new ObjModel();
-  if (!reader.ParseFromFile(file_path)) {
+  auto* model = new ObjModel();
+  if (!ObjParser::Parse(file_path, model->vertices, model->indices)) {
+    delete model;
     return nullptr;
   }
-
-  for (const auto& shape : reader.GetShapes()) {
-    for (const auto& index : shape.mesh.indices) {
-      model->indices.Insert(index.vertex_index);
-    }
+  // About as fast as the parse itself, and the GPU then reuses shaded vertices instead of fetching each corner anew.
+  MeshOptimizer::Optimize(model->vertices, model->indices);
+  Math::Bounds(model->vertices.Data(), model->vertices.Count() / 3, model->lower, model->upper);
+  if (buildLods) {
+    MeshSimplifier::BuildLods(model->vertices, model->indices, model->lods);
+  }
+  else {
+    model->lods.Insert({ 0, model->indices.Count(), 0.0f, 0 });
   }
+  return model;
+}
 
-  for (const auto& vertex : reader.GetAttrib().vertices) {
-    model->vertices.Insert(vertex);
+ObjModel* ObjModel::FromMesh(const char* file_path)
+{
+  MappedFile* mesh = MeshFile::Open(file_path);
+  if (!mesh) {
+    return nullptr;
   }
+  auto* model = new ObjModel();
+  model->mesh = mesh;
+  MeshFile::Bounds(*mesh, model->lower, model->upper);
   return model;
 }
 
@@ -7,12 +7,18 @@
 
 #include <vulkan/vulkan.h>
 
+#include "lib/linear_algebra.h"
 #include "lib/types.h"
 #include "lib/vector.h"
-#include "tiny_obj_loader.h"
+#include "mesh_simplifier.h"
 
 namespace NycaTech {
 
+class MappedFile;
+
+// Positions, triangle indices and LOD chain of a model, either parsed from an OBJ file or mapped from a cooked mesh.
+// The streams live in `vertices`, `indices` and `lods` for the former and in the private mapping for the latter;
+// Positions, Indices and Lods return whichever holds them.
 class ObjModel final {
 private:
   explicit ObjModel();
@@ -21,25 +27,55 @@ public:
   ObjModel(ObjModel&&) = delete;
   ObjModel(const ObjModel&) = delete;
   ObjModel(const char* file_path) = delete;
+  ~ObjModel();
 
 public:
+  // Each of these transforms every vertex position by one matrix, splitting large meshes across the shared thread
+  // pool, and refits the bounds. Rotate takes yaw, pitch and roll as Math::FromEuler does.
   bool Rotate(Float32, Float32, Float32);
   bool Move(Float32, Float32, Float32);
   bool Scale(Float32, Float32, Float32);
+  bool Bake(const Transform& transform);
+  bool Apply(const Math::Mat4& matrix);
+
+  // Vertices per job. 12k vertices are 144 KiB of positions, small enough to stay in a core's L2 between the load
+  // and the store.
+  static constexpr Uint32 TransformChunkSize = 12 * 1024;
+
+  Span<Float32>       Positions();
+  Span<const Uint32>  Indices() const;
+  Span<const MeshLod> Lods() const;
+
+  // Moves `lod` to the coarsest level whose error, projected from the model's bounding sphere as seen from `eye`,
+  // stays under LodPixelError pixels, and returns it. `projectionScale` is pixels per unit at distance one. A coarser
+  // level is only taken once it is LodHysteresis under the threshold and a finer one once the current level is that
+  // far over it, so a model resting near a switching distance does not flicker between two levels.
+  Uint32 SelectLod(const Math::Vec3& eye, Float32 projectionScale);
+
+  static constexpr Float32 LodPixelError = 1.0f;
+  static constexpr Float32 LodHysteresis = 0.25f;
 
 public:
-  static ObjModel*                         FromFile(const char* file_path);
+  // Parses, welds and cache-optimises an OBJ file and builds its LOD chain, which takes well under a second for half a
+  // million triangles. Without `buildLods` the model gets a single level; NycaTechMeshCook bakes the chain into a file
+  // for FromMesh instead.
+  static ObjModel*                         FromFile(const char* file_path, bool buildLods = true);
+  static ObjModel*                         FromMesh(const char* file_path);
   static VkVertexInputBindingDescription   GetVkVertexInputBindingDescription();
   static VkVertexInputAttributeDescription GetVkVertexInputAttributeDescription();
 
 public:
-  Transform       transform;
   VkBuffer        vertexBuffer;
   VkDeviceMemory  vertexMemory;
   VkBuffer        indexBuffer;
   VkDeviceMemory  indexMemory;
   Vector<Uint32>  indices;
   Vector<Float32> vertices;
+  Vector<MeshLod> lods;
+  MappedFile*     mesh;
+  Math::Vec3      lower;
+  Math::Vec3      upper;
+  Uint32          lod;
 };
 
 };  // namespace NycaTech
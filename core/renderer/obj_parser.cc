@@ -0,0 +1,239 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#include "obj_parser.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+#include "lib/assert.h"
+#include "lib/mapped_file.h"
+#include "thread_pool.h"
+
+namespace NycaTech {
+
+static bool IsBlank(const char c)
+{
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+static const char* SkipBlanks(const char* p, const char* end)
+{
+  while (p < end && IsBlank(*p)) {
+    p++;
+  }
+  return p;
+}
+
+static const char* SkipToken(const char* p, const char* end)
+{
+  while (p < end && !IsBlank(*p)) {
+    p++;
+  }
+  return p;
+}
+
+static const char* LineEnd(const char* p, const char* end)
+{
+  const auto* newline = static_cast<const char*>(memchr(p, '\n', end - p));
+  return newline ? newline : end;
+}
+
+// Where a line's statement stops: at a `#` starting a trailing comment, or at the end of the line.
+static const char* CommentStart(const char* p, const char* end)
+{
+  const auto* hash = static_cast<const char*>(memchr(p, '#', end - p));
+  return hash ? hash : end;
+}
+
+// The statement a line starts with: 'v' for a position, 'f' for a face and 0 for anything else. `p` is left after it.
+static char Statement(const char*& p, const char* end)
+{
+  p = SkipBlanks(p, end);
+  if (end - p >= 2 && (p[0] == 'v' || p[0] == 'f') && IsBlank(p[1])) {
+    const char statement = p[0];
+    p += 2;
+    return statement;
+  }
+  return 0;
+}
+
+static bool ParseFloat(const char*& p, const char* end, Float32& value)
+{
+  p = SkipBlanks(p, end);
+  if (p < end && *p == '+') {
+    p++;
+  }
+  const auto [next, error] = std::from_chars(p, end, value);
+  p = next;
+  return error == std::errc() && (p == end || IsBlank(*p));
+}
+
+// Splits [begin, end) into about `count` pieces, each ending just after a newline so no line straddles two chunks.
+static void Split(const char* begin, const char* end, Uint32 count, Vector<const char*>& bounds)
+{
+  const Uint64 size = end - begin;
+  bounds.Insert(begin);
+  for (Uint32 i = 1; i < count; i++) {
+    const char* cut = std::max(begin + size * i / count, bounds[bounds.Count() - 1]);
+    cut = cut < end ? LineEnd(cut, end) : end;
+    bounds.Insert(cut < end ? cut + 1 : end);
+  }
+  bounds.Insert(end);
+}
+
+bool ObjParser::Parse(const char* path, Vector<Float32>& positions, Vector<Uint32>& indices)
+{
+  MappedFile* file = MappedFile::Open(path);
+  if (!file) {
+    ErrorMessage = "unable to map OBJ file";
+    return false;
+  }
+
+  ThreadPool&  pool = ThreadPool::Shared();
+  const auto*  begin = reinterpret_cast<const char*>(file->Data());
+  const char*  end = begin + file->Size();
+  const Uint32 workers = pool.WorkerCount() + 1;
+  const auto   wanted = static_cast<Uint32>(std::clamp<Uint64>(file->Size() / MinChunkSize, 1, workers * 4));
+
+  Vector<const char*> bounds;
+  Split(begin, end, wanted, bounds);
+  Vector<Chunk> chunks;
+  for (Uint32 i = 0; i + 1 < bounds.Count(); i++) {
+    if (bounds[i] < bounds[i + 1]) {
+      chunks.Insert({ bounds[i], bounds[i + 1], 0, 0, 0, 0, nullptr });
+    }
+  }
+
+  // Every chunk but the first goes to the pool; the first runs on the calling thread.
+  const auto forEachChunk = [&pool, &chunks](auto&& fn) {
+    JobCounter remaining;
+    for (Uint32 i = 1; i < chunks.Count(); i++) {
+      pool.Submit([&chunks, &fn, i] { fn(chunks[i]); }, remaining);
+    }
+    fn(chunks[0]);
+    pool.WaitFor(remaining);
+  };
+
+  forEachChunk([](Chunk& chunk) { Count(chunk); });
+  Uint64 totalVertices = 0;
+  Uint64 totalIndices = 0;
+  for (Chunk& chunk: chunks) {
+    chunk.firstVertex = totalVertices;
+    chunk.firstIndex = totalIndices;
+    totalVertices += chunk.vertexCount;
+    totalIndices += chunk.indexCount;
+  }
+  if (totalVertices * 3 > UINT32_MAX || totalIndices > UINT32_MAX) {
+    ErrorMessage = "OBJ file holds more vertices or indices than a Vector can";
+    delete file;
+    return false;
+  }
+
+  positions.Clear();
+  positions.Reserve(static_cast<Uint32>(totalVertices * 3));
+  positions.OverrideCount(static_cast<Uint32>(totalVertices * 3));
+  indices.Clear();
+  indices.Reserve(static_cast<Uint32>(totalIndices));
+  indices.OverrideCount(static_cast<Uint32>(totalIndices));
+  forEachChunk([&positions, &indices, totalVertices](Chunk& chunk) {
+    Read(chunk, positions.Data(), indices.Data(), totalVertices);
+  });
+  delete file;
+
+  for (const Chunk& chunk: chunks) {
+    if (chunk.error) {
+      ErrorMessage = chunk.error;
+      positions.Clear();
+      indices.Clear();
+      return false;
+    }
+  }
+  return true;
+}
+
+void ObjParser::Count(Chunk& chunk)
+{
+  for (const char* line = chunk.begin; line < chunk.end;) {
+    const char* lineEnd = LineEnd(line, chunk.end);
+    const char* end = CommentStart(line, lineEnd);
+    const char* p = line;
+    const char  statement = Statement(p, end);
+    if (statement == 'v') {
+      chunk.vertexCount++;
+    }
+    else if (statement == 'f') {
+      Uint64 corners = 0;
+      for (p = SkipBlanks(p, end); p < end; p = SkipBlanks(SkipToken(p, end), end)) {
+        corners++;
+      }
+      // Degenerate faces are rejected by Read, which reports them.
+      chunk.indexCount += corners >= 3 ? (corners - 2) * 3 : 0;
+    }
+    line = lineEnd + 1;
+  }
+}
+
+void ObjParser::Read(Chunk& chunk, Float32* positions, Uint32* indices, const Uint64 totalVertices)
+{
+  Float32* position = positions + chunk.firstVertex * 3;
+  Uint32*  index = indices + chunk.firstIndex;
+  Uint64   vertex = chunk.firstVertex;
+  for (const char* line = chunk.begin; line < chunk.end;) {
+    const char* lineEnd = LineEnd(line, chunk.end);
+    const char* end = CommentStart(line, lineEnd);
+    const char* p = line;
+    const char  statement = Statement(p, end);
+    if (statement == 'v') {
+      // An optional w after the position is ignored.
+      if (!ParseFloat(p, end, position[0]) || !ParseFloat(p, end, position[1]) || !ParseFloat(p, end, position[2])) {
+        chunk.error = "malformed vertex in OBJ file";
+        return;
+      }
+      position += 3;
+      vertex++;
+    }
+    else if (statement == 'f') {
+      // Each corner is v, v/vt, v//vn or v/vt/vn; only v is read, and must end at a slash or the end of the corner.
+      // Negative indices count back from the last vertex.
+      Uint32 first = 0;
+      Uint32 previous = 0;
+      Uint32 corners = 0;
+      for (p = SkipBlanks(p, end); p < end; p = SkipBlanks(SkipToken(p, end), end)) {
+        Int64      value = 0;
+        const auto [next, error] = std::from_chars(p, end, value);
+        if (error != std::errc() || (next < end && *next != '/' && !IsBlank(*next))) {
+          chunk.error = "malformed face in OBJ file";
+          return;
+        }
+        const Int64 resolved = value > 0 ? value - 1 : static_cast<Int64>(vertex) + value;
+        if (value == 0 || resolved < 0 || static_cast<Uint64>(resolved) >= totalVertices) {
+          chunk.error = "OBJ face refers to a vertex that does not exist";
+          return;
+        }
+
+        const auto current = static_cast<Uint32>(resolved);
+        if (corners == 0) {
+          first = current;
+        }
+        else if (corners >= 2) {
+          index[0] = first;
+          index[1] = previous;
+          index[2] = current;
+          index += 3;
+        }
+        previous = current;
+        corners++;
+      }
+      if (corners < 3) {
+        chunk.error = "OBJ face has fewer than three corners";
+        return;
+      }
+    }
+    line = lineEnd + 1;
+  }
+}
+
+}  // namespace NycaTech
@@ -0,0 +1,41 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef OBJ_PARSER_H
+#define OBJ_PARSER_H
+
+#include "lib/types.h"
+#include "lib/vector.h"
+
+namespace NycaTech {
+
+// Wavefront OBJ loader for vertex positions and faces. The file is mapped and cut at line boundaries into chunks that
+// the shared thread pool parses twice: the first pass counts each chunk's vertices and face corners, which gives every
+// chunk its own range of the exactly sized outputs, and the second parses straight into that range. Faces are fan
+// triangulated and their indices made zero based; texture coordinates, normals, groups and materials are skipped.
+class ObjParser final {
+public:
+  static bool Parse(const char* path, Vector<Float32>& positions, Vector<Uint32>& indices);
+
+  // Files smaller than this are parsed on the calling thread alone.
+  static constexpr Uint64 MinChunkSize = 1 << 20;
+
+private:
+  struct Chunk {
+    const char* begin;
+    const char* end;
+    Uint64      vertexCount;
+    Uint64      indexCount;
+    Uint64      firstVertex;
+    Uint64      firstIndex;
+    const char* error;
+  };
+
+  static void Count(Chunk& chunk);
+  static void Read(Chunk& chunk, Float32* positions, Uint32* indices, Uint64 totalVertices);
+};
+
+}  // namespace NycaTech
+
+#endif  // OBJ_PARSER_H
@@ -5,7 +5,7 @@
 #include "swapchain.h"
 
 #include <lib/assert.h>
-#include <lib/vector.h>
+#include <lib/frame_arena.h>
 
 #include "device.h"
 #include "physical_device.h"
@@ -14,7 +14,7 @@
 
 namespace NycaTech::Renderer {
 
-VkSurfaceFormatKHR ChooseFormat(const Vector<VkSurfaceFormatKHR>& formats)
+VkSurfaceFormatKHR ChooseFormat(const FrameVector<VkSurfaceFormatKHR>& formats)
 {
   for (const auto& format : formats) {
     if (format.format == VK_FORMAT_B8G8R8_SRGB && format.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR) {
@@ -24,7 +24,7 @@ VkSurfaceFormatKHR ChooseFormat(const Vector<VkSurfaceFormatKHR>& formats)
   return formats[0];
 }
 
-VkPresentModeKHR ChooseMode(const Vector<VkPresentModeKHR>& modes)
+VkPresentModeKHR ChooseMode(const FrameVector<VkPresentModeKHR>& modes)
 {
   for (const auto& mode : modes) {
     if (mode == VK_PRESENT_MODE_MAILBOX_KHR) {
@@ -85,12 +85,12 @@ bool SwapChain::LoadImageViews(const Device* device)
 
 bool SwapChain::Rebuild(const PhysicalDevice* physicalDevice, const Device* device)
 {
-  Vector<VkSurfaceFormatKHR> formats;
+  FrameVector<VkSurfaceFormatKHR> formats;
   vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice->device, surface->surface, &formats.CountMut(), nullptr);
   formats.AdjustSize();
   vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice->device, surface->surface, &formats.CountMut(), formats.Data());
 
-  Vector<VkPresentModeKHR> modes;
+  FrameVector<VkPresentModeKHR> modes;
   vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice->device, surface->surface, &modes.CountMut(), nullptr);
   modes.AdjustSize();
   vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice->device, surface->surface, &modes.CountMut(), modes.Data());
@@ -7,15 +7,18 @@
 #include <SDL2/SDL_vulkan.h>
 #include <lib/assert.h>
 
+#include <cmath>
+
 namespace NycaTech::Renderer {
 
-const Vector extensions{ VK_KHR_SWAPCHAIN_EXTENSION_NAME };
+const SmallVector<const char*, 4> extensions{ VK_KHR_SWAPCHAIN_EXTENSION_NAME };
 
 #ifdef DEBUG
-const Vector layers{ "VK_LAYER_KHRONOS_validation" };
+const SmallVector<const char*, 4> layers{ "VK_LAYER_KHRONOS_validation" };
 #endif
 
 VulkanRenderer::VulkanRenderer()
+    : eye{ 0.0f, 0.0f, 0.0f }, fovY(DefaultFovY)
 {
   Assert(SetupWindow(), "unable to setup widow");
   Assert(CreateInstance(), "unable to create vulkan instance");
@@ -69,7 +72,7 @@ bool VulkanRenderer::CreateInstance()
   Uint32 eCount;
   AssertReturnFalse(SDL_Vulkan_GetInstanceExtensions(window, &eCount, nullptr), "unable to load sdl vulkan");
 
-  Vector<const char*> names(eCount);
+  FrameVector<const char*> names(eCount);
   AssertReturnFalse(SDL_Vulkan_GetInstanceExtensions(window, &eCount, names.Data()), "list instance extensions");
 
   VkApplicationInfo appInfo{ VK_STRUCTURE_TYPE_APPLICATION_INFO };
@@ -105,12 +108,12 @@ bool VulkanRenderer::CreatePhysicalDevice()
 {
   Uint32 pdCount;
   vkEnumeratePhysicalDevices(instance, &pdCount, nullptr);
-  Vector<VkPhysicalDevice> vkDevices(pdCount);
+  FrameVector<VkPhysicalDevice> vkDevices(pdCount);
   vkEnumeratePhysicalDevices(instance, &pdCount, vkDevices.Data());
 
-  Vector<VkPhysicalDevice> devices;
+  FrameVector<VkPhysicalDevice> devices;
   for (const auto& vkDevice : vkDevices) {
-    Vector<VkQueueFamilyProperties> properties;
+    FrameVector<VkQueueFamilyProperties> properties;
     vkGetPhysicalDeviceQueueFamilyProperties(vkDevice, &properties.CountMut(), nullptr);
     properties.AdjustSize();
     vkGetPhysicalDeviceQueueFamilyProperties(vkDevice, &properties.CountMut(), properties.Data());
@@ -125,7 +128,7 @@ bool VulkanRenderer::CreatePhysicalDevice()
 
 bool VulkanRenderer::IsDeviceSuitable(VkPhysicalDevice vkDevice)
 {
-  Vector<VkExtensionProperties> deviceExtensions;
+  FrameVector<VkExtensionProperties> deviceExtensions;
   vkEnumerateDeviceExtensionProperties(vkDevice, nullptr, &deviceExtensions.CountMut(), nullptr);
   deviceExtensions.AdjustSize();
   vkEnumerateDeviceExtensionProperties(vkDevice, nullptr, &deviceExtensions.CountMut(), deviceExtensions.Data());
@@ -140,14 +143,14 @@ bool VulkanRenderer::IsDeviceSuitable(VkPhysicalDevice vkDevice)
   return false;
 }
 
-Vector<Uint32> VulkanRenderer::PresentationQueueIndices() const
+FrameVector<Uint32> VulkanRenderer::PresentationQueueIndices() const
 {
-  Vector<VkQueueFamilyProperties> familyProperties;
+  FrameVector<VkQueueFamilyProperties> familyProperties;
   vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyProperties.CountMut(), nullptr);
   familyProperties.AdjustSize();
   vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyProperties.CountMut(), familyProperties.Data());
 
-  Vector<Uint32> indices;
+  FrameVector<Uint32> indices;
   for (Uint32 i = 0; i < familyProperties.Count(); i++) {
     VkBool32 canPresent;
     vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &canPresent);
@@ -158,14 +161,14 @@ Vector<Uint32> VulkanRenderer::PresentationQueueIndices() const
   return indices;
 }
 
-Vector<Uint32> VulkanRenderer::GraphicsQueueIndices() const
+FrameVector<Uint32> VulkanRenderer::GraphicsQueueIndices() const
 {
-  Vector<VkQueueFamilyProperties> familyProperties;
+  FrameVector<VkQueueFamilyProperties> familyProperties;
   vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyProperties.CountMut(), nullptr);
   familyProperties.AdjustSize();
   vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyProperties.CountMut(), familyProperties.Data());
 
-  Vector<Uint32> indices;
+  FrameVector<Uint32> indices;
   for (Uint32 i = 0; i < familyProperties.Count(); i++) {
     const auto properties = familyProperties[i];
     if (properties.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
@@ -180,9 +183,9 @@ bool VulkanRenderer::CreateLogicalDevice()
   graphicsQueueIndex = GraphicsQueueIndices()[0];
   presentQueueIndex = PresentationQueueIndices()[0];
 
-  VkPhysicalDeviceFeatures        dFeatures{ .fillModeNonSolid = VK_TRUE };
-  Float32                         queuePriority = 1.0f;
-  Vector<VkDeviceQueueCreateInfo> infos;
+  VkPhysicalDeviceFeatures                dFeatures{ .fillModeNonSolid = VK_TRUE };
+  Float32                                 queuePriority = 1.0f;
+  SmallVector<VkDeviceQueueCreateInfo, 2> infos;
 
   VkDeviceQueueCreateInfo queueInfo = { VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO };
   queueInfo.queueFamilyIndex = graphicsQueueIndex, queueInfo.queueCount = 1;
@@ -217,12 +220,12 @@ bool VulkanRenderer::CreateLogicalDevice()
 
 bool VulkanRenderer::CreateSwapChain()
 {
-  Vector<VkSurfaceFormatKHR> formats;
+  FrameVector<VkSurfaceFormatKHR> formats;
   vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &formats.CountMut(), nullptr);
   formats.AdjustSize();
   vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &formats.CountMut(), formats.Data());
 
-  Vector<VkPresentModeKHR> modes;
+  FrameVector<VkPresentModeKHR> modes;
   vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &modes.CountMut(), nullptr);
   modes.AdjustSize();
   vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &modes.CountMut(), modes.Data());
@@ -259,7 +262,7 @@ bool VulkanRenderer::CreateSwapChain()
   return true;
 }
 
-VkSurfaceFormatKHR VulkanRenderer::ChooseFormat(const Vector<VkSurfaceFormatKHR>& formats)
+VkSurfaceFormatKHR VulkanRenderer::ChooseFormat(const FrameVector<VkSurfaceFormatKHR>& formats)
 {
   for (const auto& format : formats) {
     if (format.format == VK_FORMAT_B8G8R8_SRGB && format.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR) {
@@ -269,7 +272,7 @@ VkSurfaceFormatKHR VulkanRenderer::ChooseFormat(const Vector<VkSurfaceFormatKHR>
   return formats[0];
 }
 
-VkPresentModeKHR VulkanRenderer::ChooseMode(const Vector<VkPresentModeKHR>& modes)
+VkPresentModeKHR VulkanRenderer::ChooseMode(const FrameVector<VkPresentModeKHR>& modes)
 {
   for (const auto& mode : modes) {
     if (mode == VK_PRESENT_MODE_MAILBOX_KHR) {
@@ -319,7 +322,7 @@ bool VulkanRenderer::AttachShader(const Shader& shader)
 
 bool VulkanRenderer::CreateRenderPipeline()
 {
-  Vector<VkPipelineShaderStageCreateInfo> shaderStages;
+  FrameVector<VkPipelineShaderStageCreateInfo> shaderStages;
   for (const auto& shader : vertexShaders) {
     VkPipelineShaderStageCreateInfo info{ VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO };
     info.stage = VK_SHADER_STAGE_VERTEX_BIT;
@@ -627,7 +630,7 @@ VkBuffer VulkanRenderer::CreateBuffer(VkDeviceSize          size,
   return buffer;
 }
 
-bool VulkanRenderer::CreateVertexBuffer(VkBuffer& buffer, VkDeviceMemory& memory, VkDeviceSize size, void* data)
+bool VulkanRenderer::CreateVertexBuffer(VkBuffer& buffer, VkDeviceMemory& memory, VkDeviceSize size, const void* data)
 {
   VkDeviceMemory bufferMemory;
   VkBuffer       stageBuffer = CreateBuffer(size,
@@ -651,7 +654,7 @@ bool VulkanRenderer::CreateVertexBuffer(VkBuffer& buffer, VkDeviceMemory& memory
   return true;
 }
 
-bool VulkanRenderer::CreateIndexBuffer(VkBuffer& buffer, VkDeviceMemory& memory, VkDeviceSize size, void* data)
+bool VulkanRenderer::CreateIndexBuffer(VkBuffer& buffer, VkDeviceMemory& memory, VkDeviceSize size, const void* data)
 {
   VkDeviceMemory bufferMemory;
   VkBuffer       stageBuffer = CreateBuffer(size,
@@ -700,11 +703,14 @@ bool VulkanRenderer::RecordCommandBuffer(VkCommandBuffer command, Uint32 imageIn
   VkRect2D scissor{ { 0, 0 }, extent };
   vkCmdSetScissor(command, 0, 1, &scissor);
 
-  VkDeviceSize offsets[] = { 0 };
+  // Every LOD lives in the one index buffer, so a model's level only decides which range of it is drawn.
+  const Float32 projectionScale = static_cast<Float32>(extent.height) / (2.0f * std::tan(fovY * 0.5f));
+  VkDeviceSize  offsets[] = { 0 };
   for (const auto& model : models) {
+    const MeshLod& lod = model->Lods()[model->SelectLod(eye, projectionScale)];
     vkCmdBindVertexBuffers(command, 0, 1, &model->vertexBuffer, offsets);
     vkCmdBindIndexBuffer(command, model->indexBuffer, 0, VK_INDEX_TYPE_UINT32);
-    vkCmdDrawIndexed(command, model->indices.Count(), 1, 0, 0, 0);
+    vkCmdDrawIndexed(command, lod.indexCount, 1, lod.firstIndex, 0, 0);
   }
 
   vkCmdEndRenderPass(command);
@@ -750,17 +756,16 @@ bool VulkanRenderer::CreateRenderPass()
   return vkCreateRenderPass(device, &renderPassInfo, nullptr, &renderPass) == VK_SUCCESS;
 }
 
+// Cooked models hand over their mapped pages, so their positions go from the page cache straight into staging memory.
 bool VulkanRenderer::LoadModel(ObjModel* model)
 {
-  const auto& vertices = model->vertices;
-  const auto  vertSize = sizeof(vertices[0]) * vertices.Count();
-  if (!CreateVertexBuffer(model->vertexBuffer, model->vertexMemory, vertSize, (void*)vertices.Data())) {
+  const auto vertices = model->Positions();
+  if (!CreateVertexBuffer(model->vertexBuffer, model->vertexMemory, vertices.size_bytes(), vertices.data())) {
     return false;
   }
 
-  const auto& indices = model->indices;
-  const auto  indexSize = sizeof(indices[0]) * indices.Count();
-  if (!CreateIndexBuffer(model->indexBuffer, model->indexMemory, indexSize, (void*)indices.Data())) {
+  const auto indices = model->Indices();
+  if (!CreateIndexBuffer(model->indexBuffer, model->indexMemory, indices.size_bytes(), indices.data())) {
     return false;
   }
   return models.Insert(model);
@@ -9,6 +9,8 @@
 #include <SDL2/SDL.h>
 #include <vulkan/vulkan.h>
 
+#include "lib/frame_arena.h"
+#include "lib/small_vector.h"
 #include "lib/types.h"
 #include "obj_model.h"
 #include "shader.h"
@@ -30,12 +32,16 @@ public:
   bool DrawFrame();
 
 public:
-  inline static const Vector Extensions{ VK_KHR_SWAPCHAIN_EXTENSION_NAME };
+  inline static const SmallVector<const char*, 4> Extensions{ VK_KHR_SWAPCHAIN_EXTENSION_NAME };
 #ifdef DEBUG
-  inline static const Vector Layers{ "VK_LAYER_KHRONOS_validation" };
+  inline static const SmallVector<const char*, 4> Layers{ "VK_LAYER_KHRONOS_validation" };
 #endif
+  static constexpr Float32 DefaultFovY = Math::Pi / 4.0f;
 
 public:
+  // Camera the models' LODs are chosen for each frame. `fovY` is the vertical field of view in radians.
+  Math::Vec3             eye;
+  Float32                fovY;
   SDL_Window*            window;
   VkInstance             instance;
   VkPhysicalDevice       physicalDevice;
@@ -68,35 +74,35 @@ public:
   void*                  uniformBuffersMapped[3];
 
 private:
-  bool               SetupWindow();
-  bool               CreateInstance();
-  bool               CreateSurface();
-  bool               CreatePhysicalDevice();
-  bool               IsDeviceSuitable(VkPhysicalDevice);
-  Vector<Uint32>     PresentationQueueIndices() const;
-  Vector<Uint32>     GraphicsQueueIndices() const;
-  bool               CreateLogicalDevice();
-  bool               CreateSwapChain();
-  VkSurfaceFormatKHR ChooseFormat(const Vector<VkSurfaceFormatKHR>& formats);
-  VkPresentModeKHR   ChooseMode(const Vector<VkPresentModeKHR>& modes);
-  bool               CreateImageViews();
-  bool               CreateFrameBuffers();
-  bool               CreateSynch();
-  bool               RecordCommandBuffer(VkCommandBuffer, Uint32);
-  bool               CreateRenderPass();
-  bool               CreateRenderPipeline();
-  bool               CreateCommandPool();
-  bool               CreateCommandBuffers();
-  bool               RecreateSwapChain();
-  bool               CreateUniformBuffers();
+  bool                SetupWindow();
+  bool                CreateInstance();
+  bool                CreateSurface();
+  bool                CreatePhysicalDevice();
+  bool                IsDeviceSuitable(VkPhysicalDevice);
+  FrameVector<Uint32> PresentationQueueIndices() const;
+  FrameVector<Uint32> GraphicsQueueIndices() const;
+  bool                CreateLogicalDevice();
+  bool                CreateSwapChain();
+  VkSurfaceFormatKHR  ChooseFormat(const FrameVector<VkSurfaceFormatKHR>& formats);
+  VkPresentModeKHR    ChooseMode(const FrameVector<VkPresentModeKHR>& modes);
+  bool                CreateImageViews();
+  bool                CreateFrameBuffers();
+  bool                CreateSynch();
+  bool                RecordCommandBuffer(VkCommandBuffer, Uint32);
+  bool                CreateRenderPass();
+  bool                CreateRenderPipeline();
+  bool                CreateCommandPool();
+  bool                CreateCommandBuffers();
+  bool                RecreateSwapChain();
+  bool                CreateUniformBuffers();
 
   bool     CopyBuffer(VkBuffer src, VkBuffer dst, VkDeviceSize size);
   VkBuffer CreateBuffer(VkDeviceSize          size,
                         VkBufferUsageFlags    usage,
                         VkMemoryPropertyFlags properties,
                         VkDeviceMemory&       bufferMemory);
-  bool     CreateVertexBuffer(VkBuffer& buffer, VkDeviceMemory& memory, VkDeviceSize size, void* data);
-  bool     CreateIndexBuffer(VkBuffer& buffer, VkDeviceMemory& memory, VkDeviceSize size, void* data);
+  bool     CreateVertexBuffer(VkBuffer& buffer, VkDeviceMemory& memory, VkDeviceSize size, const void* data);
+  bool     CreateIndexBuffer(VkBuffer& buffer, VkDeviceMemory& memory, VkDeviceSize size, const void* data);
 };
 
 }  // namespace NycaTech::Renderer
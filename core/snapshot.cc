@@ -0,0 +1,280 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#include "snapshot.h"
+
+#include "lib/assert.h"
+#include "lib/mapped_file.h"
+#include "world.h"
+
+namespace NycaTech {
+
+static Uint64 AlignOffset(Uint64 offset)
+{
+  return (offset + Snapshot::Alignment - 1) & ~static_cast<Uint64>(Snapshot::Alignment - 1);
+}
+
+// Sequential writer that tracks its position so every array can be padded to the offset the header promised.
+class SnapshotStream final {
+public:
+  explicit SnapshotStream(const char* path)
+      : out(path, std::ios::binary | std::ios::trunc), position(0)
+  {
+  }
+
+  bool Write(const void* bytes, Uint64 length)
+  {
+    out.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(length));
+    position += length;
+    return out.good();
+  }
+
+  bool PadTo(Uint64 offset)
+  {
+    static constexpr char zeros[Snapshot::Alignment] = {};
+    return Write(zeros, offset - position);
+  }
+
+  bool IsOpen() const
+  {
+    return out.is_open();
+  }
+
+private:
+  StreamWriter out;
+  Uint64       position;
+};
+
+bool Snapshot::Write(World& world, const char* path)
+{
+  Vector<Archetype*>          ordered;
+  HashMap<Archetype*, Uint32> indices;
+  Uint32                      columnCount = 0;
+  for (const auto& [signature, archetype]: world.archetypes) {
+    for (Uint32 i = 0; i < archetype->ColumnCount(); i++) {
+      if (!archetype->ColumnAt(i)->GetLayout().trivial) {
+        ErrorMessage = "only trivially copyable components can be written to a snapshot";
+        return false;
+      }
+    }
+    indices[archetype] = ordered.Count();
+    ordered.Insert(archetype);
+    columnCount += archetype->ColumnCount();
+  }
+
+  Header header{};
+  header.magic = Magic;
+  header.version = Version;
+  header.archetypeCount = ordered.Count();
+  header.columnCount = columnCount;
+  header.slotCount = world.slots.Count();
+  header.freeSlotCount = world.freeSlots.Count();
+  header.changeTick = world.changeTick;
+  header.archetypesOffset = AlignOffset(sizeof(Header));
+  header.columnsOffset = AlignOffset(header.archetypesOffset + sizeof(ArchetypeRecord) * header.archetypeCount);
+  header.slotsOffset = AlignOffset(header.columnsOffset + sizeof(ColumnRecord) * header.columnCount);
+  header.freeSlotsOffset = AlignOffset(header.slotsOffset + sizeof(SlotRecord) * header.slotCount);
+
+  // Lay out every entity list and column behind the tables, in the order they are streamed below.
+  Vector<ArchetypeRecord> archetypeRecords;
+  Vector<ColumnRecord>    columnRecords;
+  Uint64                  offset = header.freeSlotsOffset + sizeof(Uint32) * header.freeSlotCount;
+  for (Archetype* archetype: ordered) {
+    const Uint32 rows = archetype->Count();
+    offset = AlignOffset(offset);
+    archetypeRecords.Insert({ rows, columnRecords.Count(), archetype->ColumnCount(), 0, offset });
+    offset += sizeof(Entity) * rows;
+    for (Uint32 i = 0; i < archetype->ColumnCount(); i++) {
+      const Column::Layout& layout = archetype->ColumnAt(i)->GetLayout();
+      const Uint64          dataOffset = AlignOffset(offset);
+      const Uint64          addedOffset = AlignOffset(dataOffset + static_cast<Uint64>(layout.size) * rows);
+      const Uint64          changedOffset = AlignOffset(addedOffset + sizeof(Uint32) * rows);
+      offset = changedOffset + sizeof(Uint32) * rows;
+      columnRecords.Insert({ layout.hash, layout.size, layout.align, dataOffset, addedOffset, changedOffset });
+    }
+  }
+  header.fileSize = offset;
+
+  SnapshotStream stream(path);
+  if (!stream.IsOpen()) {
+    ErrorMessage = "unable to open snapshot for writing";
+    return false;
+  }
+
+  bool ok = stream.Write(&header, sizeof(Header)) && stream.PadTo(header.archetypesOffset)
+            && stream.Write(archetypeRecords.Data(), sizeof(ArchetypeRecord) * archetypeRecords.Count())
+            && stream.PadTo(header.columnsOffset)
+            && stream.Write(columnRecords.Data(), sizeof(ColumnRecord) * columnRecords.Count())
+            && stream.PadTo(header.slotsOffset);
+  for (Uint32 i = 0; ok && i < world.slots.Count(); i++) {
+    const auto& slot = world.slots[i];
+    SlotRecord  record{ slot.archetype ? indices[slot.archetype] : UINT32_MAX, slot.row, slot.generation };
+    ok = stream.Write(&record, sizeof(SlotRecord));
+  }
+  ok = ok && stream.PadTo(header.freeSlotsOffset)
+       && stream.Write(world.freeSlots.Data(), sizeof(Uint32) * world.freeSlots.Count());
+
+  for (Uint32 a = 0; ok && a < ordered.Count(); a++) {
+    Archetype*             archetype = ordered[a];
+    const ArchetypeRecord& archetypeRecord = archetypeRecords[a];
+    ok = stream.PadTo(archetypeRecord.entitiesOffset)
+         && stream.Write(archetype->Entities(), sizeof(Entity) * archetypeRecord.rowCount);
+    for (Uint32 i = 0; ok && i < archetype->ColumnCount(); i++) {
+      Column*             column = archetype->ColumnAt(i);
+      const ColumnRecord& record = columnRecords[archetypeRecord.firstColumn + i];
+      ok = stream.PadTo(record.dataOffset) && stream.Write(column->At(0), static_cast<Uint64>(record.size) * column->Count())
+           && stream.PadTo(record.addedOffset) && stream.Write(column->AddedTicks(), sizeof(Uint32) * column->Count())
+           && stream.PadTo(record.changedOffset)
+           && stream.Write(column->ChangedTicks(), sizeof(Uint32) * column->Count());
+    }
+  }
+
+  if (!ok) {
+    ErrorMessage = "unable to write snapshot";
+  }
+  return ok;
+}
+
+bool Snapshot::Load(World& world, const char* path)
+{
+  if (!world.slots.IsEmpty() || world.snapshot) {
+    ErrorMessage = "snapshots can only be loaded into an empty world";
+    return false;
+  }
+
+  MappedFile* file = MappedFile::Open(path, MappedFile::Mode::Private);
+  if (!file) {
+    ErrorMessage = "unable to map snapshot";
+    return false;
+  }
+
+  Uint8*        base = file->Data();
+  const Uint64  size = file->Size();
+  const auto    inBounds = [size](Uint64 offset, Uint64 length) { return offset <= size && length <= size - offset; };
+  const Header& header = *reinterpret_cast<const Header*>(base);
+  if (size < sizeof(Header) || header.magic != Magic || header.version != Version || header.fileSize != size
+      || !inBounds(header.archetypesOffset, sizeof(ArchetypeRecord) * Uint64(header.archetypeCount))
+      || !inBounds(header.columnsOffset, sizeof(ColumnRecord) * Uint64(header.columnCount))
+      || !inBounds(header.slotsOffset, sizeof(SlotRecord) * Uint64(header.slotCount))
+      || !inBounds(header.freeSlotsOffset, sizeof(Uint32) * Uint64(header.freeSlotCount))) {
+    ErrorMessage = "snapshot header is invalid or from another version";
+    delete file;
+    return false;
+  }
+
+  const auto* archetypeRecords = reinterpret_cast<const ArchetypeRecord*>(base + header.archetypesOffset);
+  const auto* columnRecords = reinterpret_cast<const ColumnRecord*>(base + header.columnsOffset);
+  const auto* slotRecords = reinterpret_cast<const SlotRecord*>(base + header.slotsOffset);
+  const auto* freeSlotRecords = reinterpret_cast<const Uint32*>(base + header.freeSlotsOffset);
+
+  // Validate everything before the world adopts any of the mapping.
+  Vector<ComponentMask> signatures;
+  for (Uint32 a = 0; a < header.archetypeCount; a++) {
+    const ArchetypeRecord& record = archetypeRecords[a];
+    bool valid = record.firstColumn <= header.columnCount
+                 && record.columnCount <= header.columnCount - record.firstColumn
+                 && inBounds(record.entitiesOffset, sizeof(Entity) * Uint64(record.rowCount));
+    ComponentMask signature;
+    for (Uint32 i = 0; valid && i < record.columnCount; i++) {
+      const ColumnRecord&   column = columnRecords[record.firstColumn + i];
+      const Column::Layout* layout = world.componentLayouts.Find(column.hash);
+      valid = layout && layout->size == column.size
+              && layout->align == column.align && layout->trivial && column.align <= Alignment
+              && column.dataOffset % column.align == 0 && column.addedOffset % alignof(Uint32) == 0
+              && column.changedOffset % alignof(Uint32) == 0
+              && inBounds(column.dataOffset, Uint64(column.size) * record.rowCount)
+              && inBounds(column.addedOffset, sizeof(Uint32) * Uint64(record.rowCount))
+              && inBounds(column.changedOffset, sizeof(Uint32) * Uint64(record.rowCount));
+      if (valid) {
+        signature.Set(layout->id);
+      }
+    }
+    // Entities whose last dense component was removed, or that hold only sparse ones, live in an archetype with no
+    // columns at all. A repeated component shows up as fewer ids than columns.
+    valid = valid && signature.Count() == record.columnCount;
+
+    // Two records with one signature would land in the same archetype, and the second could not adopt its rows.
+    for (Uint32 previous = 0; valid && previous < signatures.Count(); previous++) {
+      valid = signatures[previous] != signature;
+    }
+    if (!valid) {
+      ErrorMessage = "snapshot holds an unregistered component or a corrupt archetype";
+      delete file;
+      return false;
+    }
+    signatures.Insert(signature);
+  }
+  // A live slot must point at the row that holds its own entity, or handles and rows would disagree after loading.
+  for (Uint32 i = 0; i < header.slotCount; i++) {
+    const SlotRecord& record = slotRecords[i];
+    if (record.archetype == UINT32_MAX) {
+      continue;
+    }
+    const ArchetypeRecord* archetype = record.archetype < header.archetypeCount ? &archetypeRecords[record.archetype]
+                                                                               : nullptr;
+    const Entity* entity = archetype && record.row < archetype->rowCount
+                             ? reinterpret_cast<const Entity*>(base + archetype->entitiesOffset) + record.row
+                             : nullptr;
+    if (!entity || entity->index != i || entity->generation != record.generation) {
+      ErrorMessage = "snapshot slot points outside its archetype or at another entity's row";
+      delete file;
+      return false;
+    }
+  }
+  for (Uint32 i = 0; i < header.freeSlotCount; i++) {
+    if (freeSlotRecords[i] >= header.slotCount) {
+      ErrorMessage = "snapshot free list points outside the slot table";
+      delete file;
+      return false;
+    }
+  }
+
+  Vector<Archetype*> loaded;
+  for (Uint32 a = 0; a < header.archetypeCount; a++) {
+    const ArchetypeRecord&          record = archetypeRecords[a];
+    SmallVector<Column::Layout, 16> layouts;
+    for (Uint32 i = 0; i < record.columnCount; i++) {
+      layouts.Insert(world.componentLayouts[columnRecords[record.firstColumn + i].hash]);
+    }
+
+    Archetype* archetype = world.ArchetypeFor(signatures[a], layouts.Data(), record.columnCount);
+    for (Uint32 i = 0; i < record.columnCount; i++) {
+      const ColumnRecord& column = columnRecords[record.firstColumn + i];
+      Column*             target = archetype->ColumnOf(world.componentLayouts[column.hash].id);
+      if (!target->Adopt(base + column.dataOffset,
+                         reinterpret_cast<Uint32*>(base + column.addedOffset),
+                         reinterpret_cast<Uint32*>(base + column.changedOffset),
+                         record.rowCount)) {
+        // Validation rules this out. Earlier columns may already point into the mapping, so the world keeps it.
+        ErrorMessage = "snapshot column could not be adopted";
+        world.snapshot = file;
+        return false;
+      }
+    }
+    const auto* entities = reinterpret_cast<const Entity*>(base + record.entitiesOffset);
+    for (Uint32 row = 0; row < record.rowCount; row++) {
+      archetype->Push(entities[row]);
+    }
+    loaded.Insert(archetype);
+  }
+
+  world.slots.Resize(header.slotCount);
+  world.slots.OverrideCount(header.slotCount);
+  for (Uint32 i = 0; i < header.slotCount; i++) {
+    const SlotRecord& record = slotRecords[i];
+    Archetype*        archetype = record.archetype < loaded.Count() ? loaded[record.archetype] : nullptr;
+    world.slots[i] = { archetype, record.row, record.generation };
+  }
+  world.freeSlots.Resize(header.freeSlotCount);
+  world.freeSlots.OverrideCount(header.freeSlotCount);
+  for (Uint32 i = 0; i < header.freeSlotCount; i++) {
+    world.freeSlots[i] = freeSlotRecords[i];
+  }
+
+  world.changeTick = std::max(world.changeTick.load(), header.changeTick);
+  world.snapshot = file;
+  return true;
+}
+
+}  // namespace NycaTech
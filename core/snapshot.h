@@ -0,0 +1,71 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "lib/types.h"
+
+namespace NycaTech {
+
+class World;
+
+// Versioned binary image of every entity and component in a World. Every array in the file starts on a 64 byte
+// boundary, so Load can map the file and hand component columns the mapped pages as they are; only entity handles
+// and slots get copied. Components must be trivially copyable and registered with the loading World beforehand.
+// Columns are matched to component types by ComponentHashOf, so a snapshot loads into any run of the build that wrote
+// it whatever order component ids were handed out in. Sparse components are not written.
+class Snapshot final {
+public:
+  static bool Write(World& world, const char* path);
+  static bool Load(World& world, const char* path);
+
+  static constexpr Uint32 Magic = 0x5357594E;  // "NYWS"
+  static constexpr Uint32 Version = 2;
+  static constexpr Uint32 Alignment = 64;
+
+private:
+  struct Header {
+    Uint32 magic;
+    Uint32 version;
+    Uint64 fileSize;
+    Uint32 archetypeCount;
+    Uint32 columnCount;
+    Uint32 slotCount;
+    Uint32 freeSlotCount;
+    Uint32 changeTick;
+    Uint32 reserved;
+    Uint64 archetypesOffset;
+    Uint64 columnsOffset;
+    Uint64 slotsOffset;
+    Uint64 freeSlotsOffset;
+  };
+
+  struct ArchetypeRecord {
+    Uint32 rowCount;
+    Uint32 firstColumn;
+    Uint32 columnCount;
+    Uint32 reserved;
+    Uint64 entitiesOffset;
+  };
+
+  struct ColumnRecord {
+    Uint64 hash;
+    Uint32 size;
+    Uint32 align;
+    Uint64 dataOffset;
+    Uint64 addedOffset;
+    Uint64 changedOffset;
+  };
+
+  struct SlotRecord {
+    Uint32 archetype;
+    Uint32 row;
+    Uint32 generation;
+  };
+};
+
+}  // namespace NycaTech
+
+#endif  // SNAPSHOT_H
@@ -0,0 +1,297 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#include "spatial_index.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "lib/small_vector.h"
+#include "world.h"
+
+namespace NycaTech {
+
+static float DistanceSquared(const Vect3& lhs, const Vect3& rhs)
+{
+  const float x = lhs[0] - rhs[0];
+  const float y = lhs[1] - rhs[1];
+  const float z = lhs[2] - rhs[2];
+  return x * x + y * y + z * z;
+}
+
+SpatialIndex::SpatialIndex(const float cellSize)
+    : cellSize(cellSize),
+      inverseCellSize(1.0f / cellSize),
+      count(0),
+      lower{ INT32_MAX, INT32_MAX, INT32_MAX },
+      upper{ INT32_MIN, INT32_MIN, INT32_MIN }
+{
+}
+
+void SpatialIndex::Update(World& world, const Uint32 since)
+{
+  world.ForEachChanged<const TransformComponent>(since, [this](Entity entity, const TransformComponent& component) {
+    Insert(entity, component.transform.position);
+  });
+}
+
+void SpatialIndex::Remove(Entity entity)
+{
+  if (entity.index < entries.Count() && entries[entity.index].entity == entity) {
+    Unlink(entity.index);
+    entries[entity.index].entity = NullEntity;
+    count--;
+  }
+}
+
+Uint32 SpatialIndex::Count() const
+{
+  return count;
+}
+
+float SpatialIndex::CellSize() const
+{
+  return cellSize;
+}
+
+void SpatialIndex::QueryRadius(const Vect3& center, const float radius, Vector<Entity>& out) const
+{
+  const float radiusSquared = radius * radius;
+  const Cell  min = CellOf({ center[0] - radius, center[1] - radius, center[2] - radius });
+  const Cell  max = CellOf({ center[0] + radius, center[1] + radius, center[2] + radius });
+  ForEachInCells(min, max, [&](const Entry& entry) {
+    if (DistanceSquared(entry.position, center) <= radiusSquared) {
+      out.Insert(entry.entity);
+    }
+  });
+}
+
+void SpatialIndex::QueryBox(const Vect3& min, const Vect3& max, Vector<Entity>& out) const
+{
+  ForEachInCells(CellOf(min), CellOf(max), [&](const Entry& entry) {
+    const Vect3& p = entry.position;
+    if (p[0] >= min[0] && p[0] <= max[0] && p[1] >= min[1] && p[1] <= max[1] && p[2] >= min[2] && p[2] <= max[2]) {
+      out.Insert(entry.entity);
+    }
+  });
+}
+
+void SpatialIndex::QueryNearest(const Vect3& point, const Uint32 k, Vector<Entity>& out) const
+{
+  if (k == 0 || count == 0) {
+    return;
+  }
+
+  struct Candidate {
+    float  distance;
+    Entity entity;
+  };
+  // Max-heap on distance holding the best k seen so far.
+  SmallVector<Candidate, 16> best;
+  const auto                 farther = [](const Candidate& lhs, const Candidate& rhs) { return lhs.distance < rhs.distance; };
+  const auto                 consider = [&](const Entry& entry) {
+    const float distance = DistanceSquared(entry.position, point);
+    if (best.Count() == k) {
+      if (distance >= best[0].distance) {
+        return;
+      }
+      std::pop_heap(best.begin(), best.end(), farther);
+      best.OverrideCount(best.Count() - 1);
+    }
+    best.Insert({ distance, entry.entity });
+    std::push_heap(best.begin(), best.end(), farther);
+  };
+
+  // Visit rings of cells at growing Chebyshev distance from the point's cell. Anything beyond ring r is at least
+  // r cells away, so the search ends once the k-th best is closer than that or the rings cover every occupied cell.
+  const Cell center = CellOf(point);
+  for (Int32 ring = 0;; ring++) {
+    const Cell min{ center.x - ring, center.y - ring, center.z - ring };
+    const Cell max{ center.x + ring, center.y + ring, center.z + ring };
+    const auto onRing = [&](const Cell& cell) {
+      return std::max({ std::abs(cell.x - center.x), std::abs(cell.y - center.y), std::abs(cell.z - center.z) }) == ring;
+    };
+    const Uint64 side = 2 * static_cast<Uint64>(ring) + 1;
+    const Uint64 inner = ring > 0 ? side - 2 : 0;
+    if (side * side * side - inner * inner * inner > cells.Count()) {
+      for (const auto& [key, head]: cells) {
+        if (onRing(FromKey(key))) {
+          for (Uint32 index = head; index != None; index = entries[index].next) {
+            consider(entries[index]);
+          }
+        }
+      }
+    }
+    else {
+      for (Int32 x = min.x; x <= max.x; x++) {
+        for (Int32 y = min.y; y <= max.y; y++) {
+          const bool edge = x == min.x || x == max.x || y == min.y || y == max.y;
+          for (Int32 z = min.z; z <= max.z; z += edge || ring == 0 ? 1 : max.z - min.z) {
+            if (x < lower.x || x > upper.x || y < lower.y || y > upper.y || z < lower.z || z > upper.z) {
+              continue;
+            }
+            const Uint32* head = cells.Find(KeyOf({ x, y, z }));
+            if (!head) {
+              continue;
+            }
+            for (Uint32 index = *head; index != None; index = entries[index].next) {
+              consider(entries[index]);
+            }
+          }
+        }
+      }
+    }
+
+    const float reach = static_cast<float>(ring) * cellSize;
+    if (best.Count() == k && best[0].distance <= reach * reach) {
+      break;
+    }
+    if (min.x <= lower.x && min.y <= lower.y && min.z <= lower.z && max.x >= upper.x && max.y >= upper.y
+        && max.z >= upper.z) {
+      break;
+    }
+  }
+
+  std::sort_heap(best.begin(), best.end(), farther);
+  for (const Candidate& candidate: best) {
+    out.Insert(candidate.entity);
+  }
+}
+
+SpatialIndex::Cell SpatialIndex::CellOf(const Vect3& position) const
+{
+  const auto axis = [this](float value) {
+    const float cell = std::floor(value * inverseCellSize);
+    return static_cast<Int32>(std::clamp(cell, static_cast<float>(-CellBias), static_cast<float>(CellBias - 1)));
+  };
+  return { axis(position[0]), axis(position[1]), axis(position[2]) };
+}
+
+void SpatialIndex::Insert(Entity entity, const Vect3& position)
+{
+  if (entity.index >= entries.Count()) {
+    // Resize sets the capacity exactly, so grow geometrically or populating a fresh world becomes quadratic.
+    const Uint32 previousCount = entries.Count();
+    if (entity.index >= entries.Capacity()) {
+      entries.Reserve(std::max(entity.index + 1, entries.Capacity() + entries.Capacity() / 2));
+    }
+    entries.OverrideCount(entity.index + 1);
+    for (Uint32 i = previousCount; i < entries.Count(); i++) {
+      entries[i].entity = NullEntity;
+    }
+  }
+
+  Entry&       entry = entries[entity.index];
+  const Uint64 key = KeyOf(CellOf(position));
+  if (entry.entity == entity) {
+    entry.position = position;
+    if (entry.cell == key) {
+      return;
+    }
+    Unlink(entity.index);
+  }
+  else {
+    // A different generation here was despawned without being removed; its slot is ours now.
+    if (entry.entity != NullEntity) {
+      Unlink(entity.index);
+      count--;
+    }
+    entry.entity = entity;
+    entry.position = position;
+    count++;
+  }
+  Link(entity.index, key);
+}
+
+void SpatialIndex::Link(const Uint32 index, const Uint64 key)
+{
+  Entry& entry = entries[index];
+  auto [head, inserted] = cells.TryEmplace(key, None);
+  entry.cell = key;
+  entry.previous = None;
+  entry.next = *head;
+  if (*head != None) {
+    entries[*head].previous = index;
+  }
+  *head = index;
+
+  if (inserted) {
+    const Cell coordinates = FromKey(key);
+    lower = { std::min(lower.x, coordinates.x), std::min(lower.y, coordinates.y), std::min(lower.z, coordinates.z) };
+    upper = { std::max(upper.x, coordinates.x), std::max(upper.y, coordinates.y), std::max(upper.z, coordinates.z) };
+  }
+}
+
+void SpatialIndex::Unlink(const Uint32 index)
+{
+  const Entry& entry = entries[index];
+  if (entry.next != None) {
+    entries[entry.next].previous = entry.previous;
+  }
+  if (entry.previous != None) {
+    entries[entry.previous].next = entry.next;
+  }
+  else if (entry.next != None) {
+    cells[entry.cell] = entry.next;
+  }
+  else {
+    cells.Erase(entry.cell);
+  }
+}
+
+Uint64 SpatialIndex::KeyOf(const Cell& cell)
+{
+  return static_cast<Uint64>(cell.x + CellBias) << 42 | static_cast<Uint64>(cell.y + CellBias) << 21
+         | static_cast<Uint64>(cell.z + CellBias);
+}
+
+SpatialIndex::Cell SpatialIndex::FromKey(const Uint64 key)
+{
+  constexpr Uint64 mask = (1 << 21) - 1;
+  return { static_cast<Int32>(key >> 42 & mask) - CellBias,
+           static_cast<Int32>(key >> 21 & mask) - CellBias,
+           static_cast<Int32>(key & mask) - CellBias };
+}
+
+// Calls `fn` for every entry in the cells between min and max. When the range spans more cells than are occupied it
+// walks the occupied cells instead, so a huge query never costs more than a full scan.
+template <typename Fn>
+void SpatialIndex::ForEachInCells(const Cell& min, const Cell& max, Fn&& fn) const
+{
+  const Cell from{ std::max(min.x, lower.x), std::max(min.y, lower.y), std::max(min.z, lower.z) };
+  const Cell to{ std::min(max.x, upper.x), std::min(max.y, upper.y), std::min(max.z, upper.z) };
+  if (from.x > to.x || from.y > to.y || from.z > to.z) {
+    return;
+  }
+
+  const Uint64 volume = static_cast<Uint64>(to.x - from.x + 1) * (to.y - from.y + 1) * (to.z - from.z + 1);
+  if (volume > cells.Count()) {
+    for (const auto& [key, head]: cells) {
+      const Cell cell = FromKey(key);
+      if (cell.x >= from.x && cell.x <= to.x && cell.y >= from.y && cell.y <= to.y && cell.z >= from.z
+          && cell.z <= to.z) {
+        for (Uint32 index = head; index != None; index = entries[index].next) {
+          fn(entries[index]);
+        }
+      }
+    }
+    return;
+  }
+
+  for (Int32 x = from.x; x <= to.x; x++) {
+    for (Int32 y = from.y; y <= to.y; y++) {
+      for (Int32 z = from.z; z <= to.z; z++) {
+        const Uint32* head = cells.Find(KeyOf({ x, y, z }));
+        if (!head) {
+          continue;
+        }
+        for (Uint32 index = *head; index != None; index = entries[index].next) {
+          fn(entries[index]);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace NycaTech
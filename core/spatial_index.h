@@ -0,0 +1,93 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include "component.h"
+#include "entity.h"
+#include "lib/hash_map.h"
+#include "lib/types.h"
+#include "lib/vector.h"
+
+namespace NycaTech {
+
+class World;
+
+// World-space placement of an entity. Every entity holding one is kept in the World's SpatialIndex.
+struct TransformComponent final : Component {
+  explicit TransformComponent(const Transform& transform = Transform())
+      : transform(transform)
+  {
+  }
+
+  Transform transform;
+};
+
+// Uniform hash grid over the positions of every TransformComponent. The World catches it up at each sync point from
+// the transforms changed since the previous one, so it never changes while systems run and any number of them can
+// query it in parallel. Results reflect positions as of the last sync point.
+class SpatialIndex final {
+public:
+   explicit SpatialIndex(float cellSize = DefaultCellSize);
+   SpatialIndex(SpatialIndex&&) = delete;
+   SpatialIndex(const SpatialIndex&) = delete;
+  ~SpatialIndex() = default;
+
+public:
+  void   Update(World& world, Uint32 since);
+  void   Remove(Entity entity);
+  Uint32 Count() const;
+  float  CellSize() const;
+
+  // Queries append to `out` so callers can reuse one Vector across calls. QueryNearest appends nearest first.
+  void QueryRadius(const Vect3& center, float radius, Vector<Entity>& out) const;
+  void QueryBox(const Vect3& min, const Vect3& max, Vector<Entity>& out) const;
+  void QueryNearest(const Vect3& point, Uint32 k, Vector<Entity>& out) const;
+
+  static constexpr float DefaultCellSize = 8.0f;
+
+private:
+  // Entries are indexed by entity slot and threaded into a doubly linked list per occupied cell, so moving an entity
+  // to another cell is O(1).
+  struct Entry {
+    Entity entity;
+    Vect3  position;
+    Uint64 cell;
+    Uint32 previous;
+    Uint32 next;
+  };
+
+  struct Cell {
+    Int32 x;
+    Int32 y;
+    Int32 z;
+  };
+
+  Cell          CellOf(const Vect3& position) const;
+  void          Insert(Entity entity, const Vect3& position);
+  void          Link(Uint32 index, Uint64 key);
+  void          Unlink(Uint32 index);
+  static Uint64 KeyOf(const Cell& cell);
+  static Cell   FromKey(Uint64 key);
+
+  template <typename Fn>
+  void ForEachInCells(const Cell& min, const Cell& max, Fn&& fn) const;
+
+  static constexpr Uint32 None = UINT32_MAX;
+  static constexpr Int32  CellBias = 1 << 20;
+
+private:
+  float                   cellSize;
+  float                   inverseCellSize;
+  Vector<Entry>           entries;
+  HashMap<Uint64, Uint32> cells;
+  Uint32                  count;
+  Cell                    lower;
+  Cell                    upper;
+};
+
+}  // namespace NycaTech
+
+#endif  // SPATIAL_INDEX_H
@@ -3,3 +3,27 @@
 //
 
 #include "system.h"
+
+namespace NycaTech {
+
+ComponentMask System::Reads() const
+{
+  return ComponentMask();
+}
+
+ComponentMask System::Writes() const
+{
+  return ComponentMask::All();
+}
+
+bool System::ConflictsWith(const System& other) const
+{
+  return Writes().Intersects(other.Reads() | other.Writes()) || other.Writes().Intersects(Reads());
+}
+
+Uint32 System::LastRun() const
+{
+  return lastRun;
+}
+
+}  // namespace NycaTech
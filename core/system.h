@@ -5,15 +5,36 @@
 #ifndef SYSTEM_H
 #define SYSTEM_H
 
+#include "component.h"
 #include "entity.h"
 #include "lib/types.h"
 
 namespace NycaTech {
 
+class World;
+
 class System {
 public:
   virtual ~    System() = default;
-  virtual void Run(Vector<Entity*>& entities, float delta) = 0;
+  virtual void Run(World& world, float delta) = 0;
+
+  // Components the system touches, usually built with World::SignatureOf. World runs systems whose masks don't
+  // conflict at the same time; the default claims write access to everything, which keeps an undeclared system
+  // ordered against all others.
+  virtual ComponentMask Reads() const;
+  virtual ComponentMask Writes() const;
+
+  bool ConflictsWith(const System& other) const;
+
+  // World change tick at which the previous run started; pass it to World::ForEachChanged / ForEachAdded to only see
+  // what other systems touched since.
+  Uint32 LastRun() const;
+
+private:
+  friend class World;
+
+  Uint32 lastRun = 0;
+  Uint32 thisRun = 0;
 };
 
 }  // namespace NycaTech
@@ -0,0 +1,35 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef EXPECT_H
+#define EXPECT_H
+
+#include <cstdio>
+
+#include "lib/types.h"
+
+namespace NycaTech::Tests {
+
+// Each test under core/tests is its own executable: main runs the checks and returns Failures(), which CTest reads
+// as pass or fail. Failed checks print where they are and carry on, so one run reports all of them.
+inline Uint32 failures = 0;
+
+inline void Report(bool passed, const char* expression, const char* file, int line)
+{
+  if (!passed) {
+    fprintf(stderr, "%s:%d: expected %s\n", file, line, expression);
+    failures++;
+  }
+}
+
+inline int Failures()
+{
+  return failures == 0 ? 0 : 1;
+}
+
+}  // namespace NycaTech::Tests
+
+#define Expect(expression) ::NycaTech::Tests::Report(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
+
+#endif  // EXPECT_H
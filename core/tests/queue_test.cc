@@ -0,0 +1,142 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#include "expect.h"
+#include "lib/mpmc_queue.h"
+#include "lib/spsc_queue.h"
+#include "lib/vector.h"
+
+using namespace NycaTech;
+
+// Small enough that producers keep catching up with consumers and every index wraps many times.
+static constexpr Uint32 Capacity = 64;
+static constexpr Uint32 BatchSize = 16;
+static constexpr Uint32 ItemsPerProducer = 200'000;
+
+// Pushes `count` consecutive values starting at `first`, one at a time or in batches.
+template <typename Queue>
+static void Produce(Queue& queue, Uint64 first, Uint32 count, bool batched)
+{
+  Uint64 batch[BatchSize];
+  for (Uint32 sent = 0; sent < count;) {
+    Uint32 pushed;
+    if (batched) {
+      const Uint32 wanted = std::min(BatchSize, count - sent);
+      for (Uint32 i = 0; i < wanted; i++) {
+        batch[i] = first + sent + i;
+      }
+      pushed = queue.PushBatch(batch, wanted);
+    }
+    else {
+      pushed = queue.TryPush(first + sent) ? 1 : 0;
+    }
+    sent += pushed;
+    if (pushed == 0) {
+      yield();
+    }
+  }
+}
+
+// Pops into `batch`, one at a time or in batches, and returns how many arrived.
+template <typename Queue>
+static Uint32 Consume(Queue& queue, Uint64* batch, bool batched)
+{
+  const Uint32 popped = batched ? queue.PopBatch(batch, BatchSize) : queue.TryPop(batch[0]) ? 1 : 0;
+  if (popped == 0) {
+    yield();
+  }
+  return popped;
+}
+
+// One producer, one consumer: every value arrives exactly once and in the order it was pushed.
+static void SpscDeliversInOrder(bool batchedPush, bool batchedPop)
+{
+  SpscQueue<Uint64> queue(Capacity);
+  Thread            producer([&queue, batchedPush] { Produce(queue, 0, ItemsPerProducer, batchedPush); });
+
+  Uint64 expected = 0;
+  bool   ordered = true;
+  Uint64 batch[BatchSize];
+  while (expected < ItemsPerProducer) {
+    const Uint32 popped = Consume(queue, batch, batchedPop);
+    for (Uint32 i = 0; i < popped; i++) {
+      ordered = ordered && batch[i] == expected;
+      expected++;
+    }
+  }
+  producer.join();
+
+  Expect(ordered);
+  Expect(!queue.TryPop(batch[0]));
+}
+
+// Several producers and consumers: every pushed value is popped exactly once, and each consumer sees any one
+// producer's values in the order that producer pushed them.
+static void MpmcDeliversExactlyOnce(bool batchedPush, bool batchedPop)
+{
+  static constexpr Uint32 Producers = 4;
+  static constexpr Uint32 Consumers = 4;
+  static constexpr Uint64 Total = Uint64(Producers) * ItemsPerProducer;
+
+  MpmcQueue<Uint64> queue(Capacity);
+  Atomic<Uint64>    consumed = 0;
+  Vector<Uint64>    received[Consumers];
+  bool              ordered[Consumers];
+  Thread            threads[Producers + Consumers];
+  for (Uint32 p = 0; p < Producers; p++) {
+    threads[p] = Thread([&queue, p, batchedPush] {
+      Produce(queue, Uint64(p) * ItemsPerProducer, ItemsPerProducer, batchedPush);
+    });
+  }
+  for (Uint32 c = 0; c < Consumers; c++) {
+    threads[Producers + c] = Thread([&queue, &consumed, &received, &ordered, c, batchedPop] {
+      Uint64 last[Producers];
+      Uint64 batch[BatchSize];
+      for (Uint64& value: last) {
+        value = UINT64_MAX;
+      }
+      ordered[c] = true;
+      while (consumed.load(std::memory_order_relaxed) < Total) {
+        const Uint32 popped = Consume(queue, batch, batchedPop);
+        for (Uint32 i = 0; i < popped; i++) {
+          const Uint64 producer = batch[i] / ItemsPerProducer % Producers;
+          ordered[c] = ordered[c] && (last[producer] == UINT64_MAX || batch[i] > last[producer]);
+          last[producer] = batch[i];
+          received[c].Insert(batch[i]);
+        }
+        consumed.fetch_add(popped, std::memory_order_relaxed);
+      }
+    });
+  }
+  for (Thread& thread: threads) {
+    thread.join();
+  }
+
+  Vector<Uint8> seen(static_cast<Uint32>(Total));
+  bool          once = true;
+  Uint64        count = 0;
+  for (Uint32 c = 0; c < Consumers; c++) {
+    Expect(ordered[c]);
+    for (const Uint64 value: received[c]) {
+      once = once && value < Total && seen[static_cast<Uint32>(value)]++ == 0;
+      count++;
+    }
+  }
+  Expect(once);
+  Expect(count == Total);
+
+  Uint64 leftover;
+  Expect(!queue.TryPop(leftover));
+}
+
+int main()
+{
+  for (const bool batchedPush: { false, true }) {
+    for (const bool batchedPop: { false, true }) {
+      SpscDeliversInOrder(batchedPush, batchedPop);
+      MpmcDeliversExactlyOnce(batchedPush, batchedPop);
+    }
+  }
+  return Tests::Failures();
+}
@@ -0,0 +1,161 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#include "expect.h"
+#include "lib/assert.h"
+#include "snapshot.h"
+#include "world.h"
+
+using namespace NycaTech;
+
+struct Health : Component {
+  Health(Int32 value = 0) : value(value) {}
+
+  Int32 value;
+};
+
+struct Velocity : Component {
+  Velocity(Float32 x = 0.0f) : x(x) {}
+
+  Float32 x;
+};
+
+struct Stunned : Component {
+  static constexpr bool Sparse = true;
+};
+
+// Writes a world holding entities in every kind of archetype, including the column-less one that entities without
+// dense components live in, and checks that a fresh world loads it back unchanged.
+static void RoundTrip(const char* path)
+{
+  Entity healthy;
+  Entity moving;
+  Entity stripped;
+  Entity bare;
+  Entity stunned;
+  Entity despawned;
+  {
+    World world;
+    for (Int32 i = 0; i < 100; i++) {
+      world.Spawn(Health(i), Velocity(static_cast<Float32>(i)));
+    }
+    healthy = world.Spawn(Health(7));
+    moving = world.Spawn(Health(8), Velocity(2.5f));
+    stripped = world.Spawn(Health(9));
+    Expect(world.RemoveComponent<Health>(stripped));
+    bare = world.Spawn(Velocity(1.0f));
+    Expect(world.RemoveComponent<Velocity>(bare));
+    stunned = world.Spawn(Velocity(1.0f));
+    world.AddComponent(stunned, Stunned());
+    Expect(world.RemoveComponent<Velocity>(stunned));
+    despawned = world.Spawn(Health(10));
+    world.Despawn(despawned);
+    world.Tick(0.0f);
+    Expect(world.Signature(stripped).IsEmpty());
+    Expect(Snapshot::Write(world, path));
+  }
+
+  World unregistered;
+  Expect(!Snapshot::Load(unregistered, path));
+
+  World world;
+  world.Register<Health>();
+  world.Register<Velocity>();
+  Expect(Snapshot::Load(world, path));
+  Expect(world.IsAlive(healthy) && world.IsAlive(moving) && world.IsAlive(stripped));
+  Expect(world.IsAlive(bare) && world.IsAlive(stunned) && !world.IsAlive(despawned));
+  Expect(world.Get<Health>(healthy) && world.Get<Health>(healthy)->value == 7);
+  Expect(world.Get<Velocity>(moving) && world.Get<Velocity>(moving)->x == 2.5f);
+  Expect(!world.Get<Health>(stripped) && world.Signature(stripped).IsEmpty());
+
+  Int32 entities = 0;
+  world.ForEach<Health>([&entities](Health&) { entities++; });
+  Expect(entities == 102);
+
+  // Entities in the loaded column-less archetype still move like any other.
+  Expect(world.AddComponent(stripped, Health(11)));
+  world.Tick(0.0f);
+  Expect(world.Get<Health>(stripped) && world.Get<Health>(stripped)->value == 11);
+}
+
+static Vector<Uint8> ReadBytes(const char* path)
+{
+  std::ifstream stream(path, std::ios::binary);
+  Vector<Uint8> bytes;
+  for (auto it = std::istreambuf_iterator<char>(stream); it != std::istreambuf_iterator<char>(); ++it) {
+    bytes.Insert(static_cast<Uint8>(*it));
+  }
+  return bytes;
+}
+
+static bool LoadPatched(const Vector<Uint8>& bytes, const char* path)
+{
+  std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(bytes.Data()), bytes.Count());
+  World world;
+  world.Register<Health>();
+  world.Register<Velocity>();
+  return Snapshot::Load(world, path);
+}
+
+template<class T>
+static T& At(Vector<Uint8>& bytes, Uint64 offset)
+{
+  return *reinterpret_cast<T*>(bytes.Data() + offset);
+}
+
+// Patches records of a valid snapshot, by their offsets in Snapshot's private layout, into files that pass the
+// bounds checks but disagree with themselves. Load must refuse them rather than build a world from them.
+static void Corrupted(const char* path, const char* patchedPath)
+{
+  {
+    World world;
+    world.Spawn(Health(1));
+    world.Spawn(Health(2));
+    world.Spawn(Velocity(3.0f));
+    Expect(Snapshot::Write(world, path));
+  }
+  const Vector<Uint8> bytes = ReadBytes(path);
+  Expect(LoadPatched(bytes, patchedPath));
+
+  constexpr Uint64 ArchetypeCount = 16;
+  constexpr Uint64 ArchetypesOffset = 40;
+  constexpr Uint64 SlotsOffset = 56;
+  constexpr Uint64 ArchetypeRecordSize = 24;
+  constexpr Uint64 SlotRecordSize = 12;
+
+  // Two archetype records with the same columns.
+  Vector<Uint8> duplicated = bytes;
+  Expect(At<Uint32>(duplicated, ArchetypeCount) >= 2);
+  const Uint64 archetypes = At<Uint64>(duplicated, ArchetypesOffset);
+  std::memcpy(&duplicated[archetypes + ArchetypeRecordSize], &duplicated[archetypes], ArchetypeRecordSize);
+  Expect(!LoadPatched(duplicated, patchedPath));
+
+  // Two slots swapped onto each other's rows.
+  Vector<Uint8> swapped = bytes;
+  const Uint64  slots = At<Uint64>(swapped, SlotsOffset);
+  std::swap(At<Uint32>(swapped, slots + 4), At<Uint32>(swapped, slots + SlotRecordSize + 4));
+  Expect(!LoadPatched(swapped, patchedPath));
+
+  // A slot whose generation is not the one its row holds.
+  Vector<Uint8> stale = bytes;
+  At<Uint32>(stale, At<Uint64>(stale, SlotsOffset) + 8)++;
+  Expect(!LoadPatched(stale, patchedPath));
+}
+
+int main()
+{
+  const auto   directory = std::filesystem::temp_directory_path();
+  const String path = (directory / "nycatech_snapshot_test.snap").string();
+  const String patchedPath = (directory / "nycatech_snapshot_test_patched.snap").string();
+  RoundTrip(path.c_str());
+  Corrupted(path.c_str(), patchedPath.c_str());
+  std::filesystem::remove(path);
+  std::filesystem::remove(patchedPath);
+  return Tests::Failures();
+}
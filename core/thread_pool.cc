@@ -0,0 +1,227 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#include "thread_pool.h"
+
+#include <algorithm>
+
+namespace NycaTech {
+
+// Pool and index of the worker owning the calling thread; null and UINT32_MAX for threads outside any pool.
+static thread_local const ThreadPool* currentPool = nullptr;
+static thread_local Uint32            currentWorker = UINT32_MAX;
+
+void JobCounter::Add(const Uint32 count)
+{
+  value.fetch_add(count, std::memory_order_relaxed);
+}
+
+// The last decrement happens under the mutex and IsDone takes it before reporting zero, so once a waiter sees the
+// counter done no thread is still inside Done and the counter can be destroyed.
+void JobCounter::Done()
+{
+  Vector<Job> ready;
+  {
+    LockGuard lock(mutex);
+    if (value.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+      return;
+    }
+    ready = std::move(continuations);
+  }
+  for (Job& continuation : ready) {
+    continuation();
+  }
+}
+
+bool JobCounter::IsDone() const
+{
+  if (value.load(std::memory_order_acquire) != 0) {
+    return false;
+  }
+  LockGuard lock(mutex);
+  return value.load(std::memory_order_relaxed) == 0;
+}
+
+Uint32 JobCounter::Value() const
+{
+  return value.load(std::memory_order_acquire);
+}
+
+void JobCounter::OnZero(Job continuation)
+{
+  {
+    LockGuard lock(mutex);
+    if (value.load(std::memory_order_relaxed) != 0) {
+      continuations.Insert(std::move(continuation));
+      return;
+    }
+  }
+  continuation();
+}
+
+ThreadPool::ThreadPool(Uint32 workerCount)
+    : workers(new Worker[workerCount ? workerCount : 1]),
+      workerCount(workerCount ? workerCount : 1),
+      nextWorker(0),
+      queued(0),
+      sleepers(0),
+      stopping(false)
+{
+  for (Uint32 i = 0; i < Self.workerCount; i++) {
+    workers[i].thread = Thread(&ThreadPool::WorkerLoop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    LockGuard lock(sleepMutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (Uint32 i = 0; i < workerCount; i++) {
+    workers[i].thread.join();
+  }
+  delete[] workers;
+}
+
+// Submitters raise `queued` before reading `sleepers` and sleepers raise `sleepers` before reading `queued`, both
+// sequentially consistent, so either the submitter sees the sleeper or the sleeper sees the job. Only in the first case
+// does the submitter touch sleepMutex, which it holds while notifying so the sleeper cannot sit between its check and
+// its wait.
+void ThreadPool::Submit(Job job)
+{
+  const Uint32 index = currentPool == this ? currentWorker : nextWorker++ % workerCount;
+  {
+    LockGuard lock(workers[index].mutex);
+    workers[index].jobs.push_back(std::move(job));
+  }
+  queued++;
+  if (sleepers > 0) {
+    LockGuard lock(sleepMutex);
+    wake.notify_one();
+  }
+}
+
+void ThreadPool::Submit(Job job, JobCounter& counter)
+{
+  counter.Add();
+  Submit([job = std::move(job), &counter] {
+    job();
+    counter.Done();
+  });
+}
+
+// `counter` is raised right away, so waiting on it also covers the job still held back by `dependency`.
+void ThreadPool::SubmitAfter(JobCounter& dependency, Job job, JobCounter& counter)
+{
+  counter.Add();
+  dependency.OnZero([this, job = std::move(job), &counter] {
+    Submit([job, &counter] {
+      job();
+      counter.Done();
+    });
+  });
+}
+
+void ThreadPool::Spawn(Task task, JobCounter& counter)
+{
+  counter.Add();
+  const std::coroutine_handle<Task::promise_type> handle = std::exchange(task.handle, nullptr);
+  handle.promise().counter = &counter;
+  Submit([handle] { handle.resume(); });
+}
+
+// The waiting thread runs queued jobs instead of blocking, so waiting from inside a job cannot starve the pool.
+void ThreadPool::WaitFor(const JobCounter& counter)
+{
+  while (!counter.IsDone()) {
+    if (!TryRun(CurrentWorker())) {
+      yield();
+    }
+  }
+}
+
+Uint32 ThreadPool::WorkerCount() const
+{
+  return workerCount;
+}
+
+Uint32 ThreadPool::CurrentWorker() const
+{
+  return currentPool == this ? currentWorker : UINT32_MAX;
+}
+
+ThreadPool& ThreadPool::Shared()
+{
+  static ThreadPool shared(std::max(Thread::hardware_concurrency(), 2u) - 1);
+  return shared;
+}
+
+ThreadPool::ScheduleAwaiter ThreadPool::Schedule()
+{
+  return { Self };
+}
+
+ThreadPool::CompletionAwaiter ThreadPool::Completion(JobCounter& counter)
+{
+  return { Self, counter };
+}
+
+bool ThreadPool::TryRun(Uint32 self)
+{
+  Job job;
+  if (!(self < workerCount && Pop(self, job)) && !Steal(self, job)) {
+    return false;
+  }
+  queued--;
+  job();
+  return true;
+}
+
+bool ThreadPool::Pop(Uint32 index, Job& job)
+{
+  LockGuard lock(workers[index].mutex);
+  if (workers[index].jobs.empty()) {
+    return false;
+  }
+  job = std::move(workers[index].jobs.back());
+  workers[index].jobs.pop_back();
+  return true;
+}
+
+bool ThreadPool::Steal(Uint32 index, Job& job)
+{
+  const Uint32 start = index < workerCount ? index + 1 : 0;
+  for (Uint32 i = 0; i < workerCount; i++) {
+    Worker& victim = workers[(start + i) % workerCount];
+    LockGuard lock(victim.mutex);
+    if (!victim.jobs.empty()) {
+      job = std::move(victim.jobs.front());
+      victim.jobs.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::WorkerLoop(Uint32 index)
+{
+  currentPool = this;
+  currentWorker = index;
+  for (;;) {
+    if (TryRun(index)) {
+      continue;
+    }
+    UniqueLock lock(sleepMutex);
+    sleepers++;
+    wake.wait(lock, [this] { return stopping || queued > 0; });
+    sleepers--;
+    if (stopping) {
+      return;
+    }
+  }
+}
+
+}  // namespace NycaTech
@@ -0,0 +1,173 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <utility>
+
+#include "lib/types.h"
+#include "lib/vector.h"
+
+namespace NycaTech {
+
+class ThreadPool;
+
+// Counts outstanding jobs. Jobs submitted against a counter raise it and lower it when they finish; other jobs can be
+// chained to run once it drops to zero, and threads or tasks can wait for that.
+class JobCounter final {
+public:
+  using Job = std::function<void()>;
+
+   JobCounter() = default;
+   JobCounter(JobCounter&&) = delete;
+   JobCounter(const JobCounter&) = delete;
+  ~JobCounter() = default;
+
+public:
+  void   Add(Uint32 count = 1);
+  void   Done();
+  bool   IsDone() const;
+  Uint32 Value() const;
+
+  // Runs `continuation` once the counter reaches zero, right away if it already has.
+  void OnZero(Job continuation);
+
+private:
+  Atomic<Uint32> value = 0;
+  mutable Mutex  mutex;
+  Vector<Job>    continuations;
+};
+
+// Coroutine scheduled on a ThreadPool with ThreadPool::Spawn. It starts suspended, runs on a worker once spawned, and
+// lowers the counter it was spawned with when it returns. Inside, `co_await pool.Schedule()` hops back onto the pool
+// and `co_await pool.Completion(counter)` suspends until the counter reaches zero without blocking a worker.
+class Task final {
+public:
+  struct promise_type;
+
+  // Frees the frame before lowering the counter, so whoever waits on it never sees the task's locals alive.
+  struct FinalAwaiter {
+    bool await_ready() noexcept { return false; }
+    void await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+    {
+      JobCounter* counter = handle.promise().counter;
+      handle.destroy();
+      if (counter) {
+        counter->Done();
+      }
+    }
+    void await_resume() noexcept {}
+  };
+
+  struct promise_type {
+    JobCounter* counter = nullptr;
+
+    Task                get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(Self)); }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    FinalAwaiter        final_suspend() noexcept { return {}; }
+    void                return_void() {}
+    void                unhandled_exception() { std::terminate(); }
+  };
+
+   Task(Task&& other) noexcept
+      : handle(std::exchange(other.handle, nullptr))
+  {
+  }
+   Task(const Task&) = delete;
+  ~Task()
+  {
+    if (handle) {
+      handle.destroy();
+    }
+  }
+
+private:
+  friend class ThreadPool;
+
+  explicit Task(std::coroutine_handle<promise_type> handle)
+      : handle(handle)
+  {
+  }
+
+  std::coroutine_handle<promise_type> handle;
+};
+
+// Fixed set of workers, each owning a job deque. Workers pop their own jobs LIFO and steal from the others FIFO when
+// they run dry, so fan-out work started on one worker spreads across the pool. Shared() is the process-wide pool that
+// the ECS, asset loading and networking schedule onto; it leaves one core for the thread that waits on it, which
+// runs jobs too while it waits.
+class ThreadPool final {
+public:
+  using Job = std::function<void()>;
+
+   explicit ThreadPool(Uint32 workerCount);
+   ThreadPool(ThreadPool&&) = delete;
+   ThreadPool(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+public:
+  void   Submit(Job job);
+  void   Submit(Job job, JobCounter& counter);
+  void   SubmitAfter(JobCounter& dependency, Job job, JobCounter& counter);
+  void   Spawn(Task task, JobCounter& counter);
+  void   WaitFor(const JobCounter& counter);
+  Uint32 WorkerCount() const;
+  Uint32 CurrentWorker() const;
+
+  static ThreadPool& Shared();
+
+  struct ScheduleAwaiter {
+    ThreadPool& pool;
+
+    bool await_ready() noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) { pool.Submit([handle] { handle.resume(); }); }
+    void await_resume() noexcept {}
+  };
+
+  struct CompletionAwaiter {
+    ThreadPool& pool;
+    JobCounter& counter;
+
+    bool await_ready() noexcept { return counter.IsDone(); }
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+      ThreadPool& target = pool;
+      counter.OnZero([&target, handle] { target.Submit([handle] { handle.resume(); }); });
+    }
+    void await_resume() noexcept {}
+  };
+
+  ScheduleAwaiter   Schedule();
+  CompletionAwaiter Completion(JobCounter& counter);
+
+private:
+  struct Worker {
+    Thread     thread;
+    Mutex      mutex;
+    Deque<Job> jobs;
+  };
+
+  bool TryRun(Uint32 self);
+  bool Pop(Uint32 index, Job& job);
+  bool Steal(Uint32 index, Job& job);
+  void WorkerLoop(Uint32 index);
+
+private:
+  Worker*           workers;
+  Uint32            workerCount;
+  Atomic<Uint32>    nextWorker;
+  Atomic<Uint32>    queued;
+  Atomic<Uint32>    sleepers;
+  Mutex             sleepMutex;
+  ConditionVariable wake;
+  bool              stopping;
+};
+
+}  // namespace NycaTech
+
+#endif  // THREAD_POOL_H
@@ -0,0 +1,54 @@
+//
+// Created by rplaz on 2026-10-16.
+//
+
+#include <cstdio>
+
+#include "lib/assert.h"
+#include "renderer/mesh_file.h"
+#include "renderer/mesh_optimizer.h"
+#include "renderer/mesh_simplifier.h"
+#include "renderer/obj_parser.h"
+
+using namespace NycaTech;
+
+// Converts an OBJ file into the binary mesh ObjModel::FromMesh maps at startup, welding duplicate vertices, reordering
+// triangles and vertices for the GPU caches and building the LOD chain on the way.
+int main(int argc, char* argv[])
+{
+  if (argc != 3) {
+    fputs("usage: NycaTechMeshCook <input.obj> <output.mesh>\n", stderr);
+    return 2;
+  }
+
+  Vector<Float32> positions;
+  Vector<Uint32>  indices;
+  if (!ObjParser::Parse(argv[1], positions, indices)) {
+    fprintf(stderr, "%s: %s\n", argv[1], ErrorMessage);
+    return 1;
+  }
+
+  const MeshOptimizer::Report report = MeshOptimizer::Optimize(positions, indices);
+  Vector<MeshLod>             lods;
+  MeshSimplifier::BuildLods(positions, indices, lods);
+  if (!MeshFile::Write(argv[2],
+                       Span<const Float32>(positions.Data(), positions.Count()),
+                       Span<const Uint32>(indices.Data(), indices.Count()),
+                       Span<const MeshLod>(lods.Data(), lods.Count()))) {
+    fprintf(stderr, "%s: %s\n", argv[2], ErrorMessage);
+    return 1;
+  }
+  printf("%s: %u -> %u vertices, %u -> %u triangles, ACMR %.3f -> %.3f (%u entry FIFO)\n",
+         argv[2],
+         report.verticesBefore,
+         report.verticesAfter,
+         report.trianglesBefore,
+         report.trianglesAfter,
+         report.acmrBefore,
+         report.acmrAfter,
+         MeshOptimizer::CacheSize);
+  for (Uint32 level = 0; level < lods.Count(); level++) {
+    printf("  LOD %u: %u triangles, error %.4f\n", level, lods[level].indexCount / 3, lods[level].error);
+  }
+  return 0;
+}
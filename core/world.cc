@@ -4,30 +4,341 @@
 
 #include "world.h"
 
+#include <algorithm>
+
+#include "lib/frame_arena.h"
+
 namespace NycaTech {
 
+World::World(ThreadPool& pool)
+    : pool(pool),
+      commandBuffers(new CommandBuffer[pool.WorkerCount() + 1]),
+      pacer(duration_cast<MonotonicTime::duration>(duration<Float64>(1.0 / 60.0))),
+      fixedStep(pacer.Period())
+{
+}
+
 World::~World()
 {
-  for (Entity* entity: entities) {
-    delete entity;
+  for (const auto& [signature, archetype]: archetypes) {
+    delete archetype;
+  }
+  for (SystemNode* node: systems) {
+    delete node;
+  }
+  for (const auto& [signature, query]: queries) {
+    delete query;
   }
+  for (const auto& [id, pool]: sparsePools) {
+    delete pool;
+  }
+  delete[] commandBuffers;
+  delete snapshot;
 }
 
 void World::Tick(const float delta)
 {
-  for (System* system: systems) {
-    system->Run(entities, delta);
+  JobCounter remaining;
+  for (SystemNode* node: systems) {
+    node->pending = node->dependencies;
+  }
+  for (SystemNode* node: systems) {
+    if (node->dependencies == 0) {
+      pool.Submit([this, node, delta, &remaining] { RunSystem(node, delta, remaining); }, remaining);
+    }
   }
+  pool.WaitFor(remaining);
+  // Changes applied at the sync point get a tick newer than any system start of this tick, so every system sees them.
+  changeTick++;
+  ApplyCommands();
+  // Moving the tick on after the index caught up keeps writes made between ticks newer than what it has seen.
+  spatial.Update(Self, indexedTick);
+  indexedTick = changeTick++;
+  ticks++;
+}
+
+void World::Run()
+{
+  should_tick = true;
+  should_restart = true;
+
+  auto                    previous = MonotonicTime::now();
+  MonotonicTime::duration accumulator{};
+  while (should_tick) {
+    if (should_restart.exchange(false)) {
+      previous = MonotonicTime::now();
+      accumulator = {};
+      pacer.ResetStats();
+      pacer.Begin();
+    }
+
+    const auto now = MonotonicTime::now();
+    accumulator += now - previous;
+    previous = now;
+
+    const float step = duration<float>(fixedStep).count();
+    Uint32      steps = 0;
+    for (; accumulator >= fixedStep && steps < MaxCatchUpTicks; steps++) {
+      Tick(step);
+      accumulator -= fixedStep;
+    }
+    if (accumulator >= fixedStep) {
+      // Too far behind to catch up without spiralling; let simulated time slip instead.
+      accumulator = fixedStep - MonotonicTime::duration(1);
+    }
+
+    if (frameHook) {
+      frameHook(duration<float>(accumulator).count() / step);
+    }
+    // Every tick and the hook have finished, so no thread holds frame memory from this frame.
+    FrameArena::NextFrame();
+    pacer.Wait();
+  }
+}
+
+void World::Restart()
+{
+  should_restart = true;
+}
+
+void World::Stop()
+{
+  should_tick = false;
+}
+
+void World::SetTickRate(Float64 ticksPerSecond)
+{
+  fixedStep = duration_cast<MonotonicTime::duration>(duration<Float64>(1.0 / ticksPerSecond));
+}
+
+void World::SetFrameRate(Float64 framesPerSecond)
+{
+  pacer.SetPeriod(duration_cast<MonotonicTime::duration>(duration<Float64>(1.0 / framesPerSecond)));
+}
+
+void World::OnFrame(std::function<void(float alpha)> hook)
+{
+  frameHook = std::move(hook);
+}
+
+const FramePacer::Stats& World::PacingStats() const
+{
+  return pacer.GetStats();
+}
+
+Uint32 World::ChangeTick() const
+{
+  return changeTick;
+}
+
+const SpatialIndex& World::Spatial() const
+{
+  return spatial;
+}
+
+Uint64 World::TickCount() const
+{
+  return ticks;
 }
 
 void World::AddSystem(System* system)
 {
-  systems.Insert(system);
+  auto* node = new SystemNode;
+  node->system = system;
+  node->dependencies = 0;
+  for (SystemNode* other: systems) {
+    if (other->system->ConflictsWith(*system)) {
+      other->dependents.Insert(node);
+      node->dependencies++;
+    }
+  }
+  systems.Insert(node);
+}
+
+bool World::Despawn(Entity entity)
+{
+  if (!IsAlive(entity)) {
+    return false;
+  }
+
+  EntitySlot& slot = slots[entity.index];
+  if (slot.archetype->Signature().Test(ComponentIdOf<TransformComponent>())) {
+    spatial.Remove(entity);
+  }
+  for (const auto& [id, sparse]: sparsePools) {
+    sparse->Erase(entity.index);
+  }
+
+  Entity moved;
+  if (slot.archetype->SwapRemove(slot.row, &moved)) {
+    slots[moved.index].row = slot.row;
+  }
+  slot.archetype = nullptr;
+  slot.generation++;
+  freeSlots.Insert(entity.index);
+  return true;
+}
+
+bool World::IsAlive(Entity entity) const
+{
+  return entity.index < slots.Count() && slots[entity.index].generation == entity.generation
+         && slots[entity.index].archetype;
+}
+
+ComponentMask World::Signature(Entity entity) const
+{
+  return IsAlive(entity) ? slots[entity.index].archetype->Signature() : ComponentMask();
 }
 
-void World::AddEntity(Entity* entity)
+void* World::ComponentOf(Entity entity, ComponentId id)
 {
-  entities.Insert(entity);
+  if (!IsAlive(entity)) {
+    return nullptr;
+  }
+  const EntitySlot& slot = slots[entity.index];
+  if (Column* column = slot.archetype->ColumnOf(id)) {
+    return column->At(slot.row);
+  }
+  SparsePool** sparse = sparsePools.Find(id);
+  return sparse ? (*sparse)->Find(entity.index) : nullptr;
+}
+
+bool World::RemoveComponent(Entity entity, ComponentId id)
+{
+  if (!IsAlive(entity)) {
+    return false;
+  }
+  if (SparsePool** sparse = sparsePools.Find(id)) {
+    return (*sparse)->Erase(entity.index);
+  }
+
+  Archetype* source = slots[entity.index].archetype;
+  if (!source->Signature().Test(id)) {
+    return false;
+  }
+  if (id == ComponentIdOf<TransformComponent>()) {
+    spatial.Remove(entity);
+  }
+
+  ComponentMask                   signature = source->Signature();
+  SmallVector<Column::Layout, 16> layouts;
+  for (Uint32 i = 0; i < source->ColumnCount(); i++) {
+    if (source->ColumnAt(i)->GetLayout().id != id) {
+      layouts.Insert(source->ColumnAt(i)->GetLayout());
+    }
+  }
+  signature.Reset(id);
+  MoveEntity(entity, ArchetypeFor(signature, layouts.Data(), layouts.Count()));
+  return true;
+}
+
+CommandBuffer& World::Commands()
+{
+  return commandBuffers[std::min(pool.CurrentWorker(), pool.WorkerCount())];
+}
+
+void World::ForEachArchetype(const ComponentMask& signature, const std::function<void(Archetype&)>& fn)
+{
+  for (Archetype* archetype: Matching(signature)) {
+    if (archetype->Count() > 0) {
+      fn(*archetype);
+    }
+  }
+}
+
+void World::RunSystem(SystemNode* node, const float delta, JobCounter& remaining)
+{
+  node->system->lastRun = node->system->thisRun;
+  node->system->thisRun = ++changeTick;
+  node->system->Run(Self, delta);
+  for (SystemNode* dependent: node->dependents) {
+    if (dependent->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      pool.Submit([this, dependent, delta, &remaining] { RunSystem(dependent, delta, remaining); }, remaining);
+    }
+  }
+}
+
+void World::ApplyCommands()
+{
+  for (Uint32 i = 0; i <= pool.WorkerCount(); i++) {
+    commandBuffers[i].Apply(Self);
+  }
+}
+
+Archetype* World::ArchetypeFor(const ComponentMask& signature, const Column::Layout* layouts, Uint32 count)
+{
+  auto& archetype = archetypes[signature];
+  if (!archetype) {
+    // Columns are kept in id order so Archetype::ColumnOf can index them by rank.
+    SmallVector<Column::Layout, 16> sorted;
+    for (Uint32 i = 0; i < count; i++) {
+      sorted.Insert(layouts[i]);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Column::Layout& lhs, const Column::Layout& rhs) {
+      return lhs.id < rhs.id;
+    });
+    archetype = new Archetype(signature, sorted.Data(), count);
+    for (const Column::Layout& layout: sorted) {
+      componentLayouts[layout.hash] = layout;
+    }
+
+    LockGuard lock(queryMutex);
+    for (const auto& [querySignature, query]: queries) {
+      if (signature.Contains(querySignature)) {
+        query->archetypes.Insert(archetype);
+      }
+    }
+  }
+  return archetype;
+}
+
+const Vector<Archetype*>& World::Matching(const ComponentMask& signature)
+{
+  LockGuard lock(queryMutex);
+  Query*&   query = queries[signature];
+  if (!query) {
+    query = new Query;
+    query->signature = signature;
+    for (const auto& [archetypeSignature, archetype]: archetypes) {
+      if (archetypeSignature.Contains(signature)) {
+        query->archetypes.Insert(archetype);
+      }
+    }
+  }
+  return query->archetypes;
+}
+
+Entity World::AllocateSlot()
+{
+  if (!freeSlots.IsEmpty()) {
+    const Uint32 index = freeSlots[freeSlots.Count() - 1];
+    freeSlots.OverrideCount(freeSlots.Count() - 1);
+    return { index, slots[index].generation };
+  }
+  slots.Insert({ nullptr, 0, 0 });
+  return { slots.Count() - 1, 0 };
+}
+
+Uint32 World::MoveEntity(Entity entity, Archetype* target)
+{
+  EntitySlot& slot = slots[entity.index];
+  Archetype*  source = slot.archetype;
+  for (Uint32 i = 0; i < source->ColumnCount(); i++) {
+    Column* from = source->ColumnAt(i);
+    if (Column* to = target->ColumnOf(from->GetLayout().id)) {
+      const Uint32 row = to->Count();
+      from->GetLayout().move(to->Push(from->AddedTicks()[slot.row]), from->At(slot.row));
+      to->MarkChanged(row, from->ChangedTicks()[slot.row]);
+    }
+  }
+
+  Entity moved;
+  if (source->SwapRemove(slot.row, &moved)) {
+    slots[moved.index].row = slot.row;
+  }
+  slot.archetype = target;
+  slot.row = target->Push(entity);
+  return slot.row;
 }
 
-}  // namespace NycaTech
\ No newline at end of file
+}  // namespace NycaTech
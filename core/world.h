@@ -5,15 +5,29 @@
 #ifndef WORLD_H
 #define WORLD_H
 
+#include <algorithm>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+
+#include "archetype.h"
+#include "command_buffer.h"
 #include "entity.h"
+#include "frame_pacer.h"
+#include "lib/hash_map.h"
+#include "lib/mapped_file.h"
+#include "lib/small_vector.h"
+#include "lib/sparse_set.h"
 #include "lib/types.h"
+#include "spatial_index.h"
 #include "system.h"
+#include "thread_pool.h"
 
 namespace NycaTech {
 
 class World final {
 public:
-   World() = default;
+   explicit World(ThreadPool& pool = ThreadPool::Shared());
    World(World&&) = delete;
    World(const World&) = delete;
   ~World();
@@ -24,15 +38,454 @@ public:
   void Restart();
   void Stop();
 
+  // Run() advances the simulation in fixed steps of 1 / tickRate and calls the frame hook once per paced frame with
+  // how far the simulation has progressed into the next, not yet simulated, step. It then ends the FrameArena frame;
+  // loops that call Tick() themselves own the frame and call FrameArena::NextFrame() instead.
+  void                     SetTickRate(Float64 ticksPerSecond);
+  void                     SetFrameRate(Float64 framesPerSecond);
+  void                     OnFrame(std::function<void(float alpha)> hook);
+  const FramePacer::Stats& PacingStats() const;
+  Uint64                   TickCount() const;
+
+  static constexpr Uint32 MaxCatchUpTicks = 5;
+
+public:
+  void          AddSystem(System* system);
+  bool          Despawn(Entity entity);
+  bool          IsAlive(Entity entity) const;
+  ComponentMask Signature(Entity entity) const;
+  void*         ComponentOf(Entity entity, ComponentId id);
+  bool          RemoveComponent(Entity entity, ComponentId id);
+  void          ForEachArchetype(const ComponentMask& signature, const std::function<void(Archetype&)>& fn);
+
+  template <typename... Ts>
+  Entity Spawn(Ts... components);
+  template <typename T>
+  T* Get(Entity entity);
+  template <typename T>
+  T* AddComponent(Entity entity, T component);
+  template <typename T>
+  bool RemoveComponent(Entity entity);
+  template <typename T>
+  bool MarkChanged(Entity entity);
+  template <typename T>
+  void Register();
+
+  // Command buffer of the calling thread. Systems record structural changes here instead of applying them mid-tick;
+  // every buffer is replayed once the tick's system graph has finished. Threads outside the pool share one buffer, so
+  // only the thread driving the world should record from outside a system.
+  CommandBuffer& Commands();
+
 public:
-  void AddSystem(System* system);
-  void AddEntity(Entity* entity);
+  // Typed queries over every entity holding all of Ts. `fn` takes `Ts&...`, optionally preceded by the `Entity`.
+  // Components requested without const are stamped as changed for every row visited.
+  template <typename... Ts, typename Fn>
+  void ForEach(Fn&& fn);
+  template <typename... Ts, typename Fn>
+  void ParallelForEach(Fn&& fn, Uint32 chunkSize = DefaultChunkSize);
+
+  // ForEach restricted to rows whose first component was changed, or added, after the `since` change tick.
+  template <typename... Ts, typename Fn>
+  void ForEachChanged(Uint32 since, Fn&& fn);
+  template <typename... Ts, typename Fn>
+  void ForEachAdded(Uint32 since, Fn&& fn);
+
+  // Hands `fn` the matching columns of each archetype as `Span<Ts>...` of equal length.
+  template <typename... Ts, typename Fn>
+  void ForEachChunk(Fn&& fn);
+
+  // Visits every holder of a sparse component in its pool's packed order. `fn` takes `T&`, optionally preceded by the
+  // `Entity`. Sparse components keep no change ticks.
+  template <SparseComponent T, typename Fn>
+  void ForEachSparse(Fn&& fn);
+  template <SparseComponent T>
+  SparseSet<T>& Pool();
+
+  Uint32 ChangeTick() const;
+
+  // Positions of every entity holding a TransformComponent as of the last sync point. Safe to query from any system.
+  const SpatialIndex& Spatial() const;
+
+  template <typename... Ts>
+  static const ComponentMask& SignatureOf();
+
+  static constexpr Uint32 DefaultChunkSize = 4096;
+
+private:
+  friend class Snapshot;
+
+  // A registered system plus the later-registered systems it conflicts with, which must wait for it every tick.
+  struct SystemNode {
+    System*                     system;
+    SmallVector<SystemNode*, 4> dependents;
+    Uint32                      dependencies;
+    Atomic<Uint32>              pending;
+  };
+
+  // Where an entity currently lives. Slots are recycled through freeSlots once their entity is despawned. Sparse
+  // components stay out of the archetype; their pools are looked up by entity index instead.
+  struct EntitySlot {
+    Archetype* archetype;
+    Uint32     row;
+    Uint32     generation;
+  };
+
+  // Pool of one sparse component type, keyed by entity index. The base lets Despawn and ComponentOf reach a pool
+  // knowing only its id; typed access goes straight to the SparseSet.
+  struct SparsePool {
+    virtual ~SparsePool() = default;
+
+    virtual void* Find(Uint32 index) = 0;
+    virtual bool  Erase(Uint32 index) = 0;
+  };
+
+  template <typename T>
+  struct TypedSparsePool final : SparsePool {
+    SparseSet<T> set;
+
+    void* Find(Uint32 index) override { return set.Find(index); }
+    bool  Erase(Uint32 index) override { return set.Erase(index); }
+  };
+
+  // Archetypes matching a signature. Built on first use and extended as new archetypes appear, so a query never
+  // rescans the world.
+  struct Query {
+    ComponentMask      signature;
+    Vector<Archetype*> archetypes;
+  };
+
+  Archetype*                ArchetypeFor(const ComponentMask& signature, const Column::Layout* layouts, Uint32 count);
+  const Vector<Archetype*>& Matching(const ComponentMask& signature);
+  Entity                    AllocateSlot();
+  Uint32                    MoveEntity(Entity entity, Archetype* target);
+  void                      RunSystem(SystemNode* node, float delta, JobCounter& remaining);
+  void                      ApplyCommands();
+
+  template <SparseComponent T>
+  SparseSet<T>* FindPool();
+  template <typename... Ts>
+  static void Touch(Archetype& archetype, Uint32 tick);
+  template <typename... Ts, typename Fn>
+  static void RunRows(Archetype& archetype, Uint32 begin, Uint32 end, Fn& fn, Uint32 tick);
+  template <typename... Ts, typename Fn>
+  static void RunFilteredRows(Archetype& archetype, Fn& fn, const Uint32* filter, Uint32 since, Uint32 tick);
 
 private:
-  Vector<Entity*> entities;
-  Vector<System*> systems;
-  bool            should_tick = true;
+  ThreadPool&                        pool;
+  CommandBuffer*                     commandBuffers;
+  Vector<EntitySlot>                 slots;
+  Vector<Uint32>                     freeSlots;
+  Vector<SystemNode*>                systems;
+  HashMap<ComponentMask, Archetype*> archetypes;
+  HashMap<ComponentMask, Query*>     queries;
+  HashMap<Uint64, Column::Layout>    componentLayouts;
+  HashMap<ComponentId, SparsePool*>  sparsePools;
+  MappedFile*                        snapshot = nullptr;
+  SpatialIndex                       spatial;
+  Uint32                             indexedTick = 0;
+  Mutex                              queryMutex;
+  FramePacer                         pacer;
+  MonotonicTime::duration            fixedStep;
+  std::function<void(float)>         frameHook;
+  Uint64                             ticks = 0;
+  Atomic<Uint32>                     changeTick = 1;
+  Atomic<bool>                       should_tick = true;
+  Atomic<bool>                       should_restart = false;
 };
 
+// Built once per set of types, the first time it is asked for.
+template <typename... Ts>
+const ComponentMask& World::SignatureOf()
+{
+  static_assert(!(SparseComponent<std::remove_const_t<Ts>> || ...), "sparse components live outside archetypes");
+  static const ComponentMask signature = [] {
+    ComponentMask mask;
+    (mask.Set(ComponentIdOf<Ts>()), ...);
+    return mask;
+  }();
+  return signature;
+}
+
+template <typename... Ts>
+Entity World::Spawn(Ts... components)
+{
+  static_assert(DistinctComponents<Ts...>::value, "an entity holds a single component per type");
+
+  const Column::Layout layouts[] = { Column::Layout::Of<Ts>()... };
+  Archetype*           archetype = ArchetypeFor(SignatureOf<Ts...>(), layouts, sizeof...(Ts));
+  const Uint32         tick = changeTick.load(std::memory_order_relaxed);
+  (new (archetype->ColumnOf<Ts>()->Push(tick)) Ts(std::move(components)), ...);
+
+  const Entity entity = AllocateSlot();
+  slots[entity.index].archetype = archetype;
+  slots[entity.index].row = archetype->Push(entity);
+  return entity;
+}
+
+template <typename T>
+T* World::Get(Entity entity)
+{
+  if (!IsAlive(entity)) {
+    return nullptr;
+  }
+  if constexpr (SparseComponent<T>) {
+    SparseSet<T>* pool = FindPool<T>();
+    return pool ? pool->Find(entity.index) : nullptr;
+  }
+  else {
+    const EntitySlot& slot = slots[entity.index];
+    Column*           column = slot.archetype->ColumnOf<T>();
+    return column ? column->Data<T>() + slot.row : nullptr;
+  }
+}
+
+template <typename T>
+T* World::AddComponent(Entity entity, T component)
+{
+  if (!IsAlive(entity)) {
+    return nullptr;
+  }
+  if constexpr (SparseComponent<T>) {
+    return &Pool<T>().Insert(entity.index, std::move(component));
+  }
+  else {
+    if (T* existing = Get<T>(entity)) {
+      *existing = std::move(component);
+      MarkChanged<T>(entity);
+      return existing;
+    }
+
+    Archetype*                      source = slots[entity.index].archetype;
+    SmallVector<Column::Layout, 16> layouts;
+    for (Uint32 i = 0; i < source->ColumnCount(); i++) {
+      layouts.Insert(source->ColumnAt(i)->GetLayout());
+    }
+    layouts.Insert(Column::Layout::Of<T>());
+
+    Archetype* target = ArchetypeFor(source->Signature() | SignatureOf<T>(), layouts.Data(), layouts.Count());
+    T*         added = new (target->ColumnOf<T>()->Push(changeTick)) T(std::move(component));
+    MoveEntity(entity, target);
+    return added;
+  }
+}
+
+template <typename T>
+bool World::RemoveComponent(Entity entity)
+{
+  return RemoveComponent(entity, ComponentIdOf<T>());
+}
+
+// Makes T known to snapshot loading ahead of any entity holding it. Sparse components are not part of snapshots;
+// registering one creates its pool up front instead.
+template <typename T>
+void World::Register()
+{
+  if constexpr (SparseComponent<T>) {
+    Pool<T>();
+  }
+  else {
+    componentLayouts[ComponentHashOf<T>()] = Column::Layout::Of<T>();
+  }
+}
+
+template <typename T>
+bool World::MarkChanged(Entity entity)
+{
+  if constexpr (SparseComponent<T>) {
+    return Get<T>(entity) != nullptr;
+  }
+  else {
+    if (!IsAlive(entity)) {
+      return false;
+    }
+    const EntitySlot& slot = slots[entity.index];
+    Column*           column = slot.archetype->ColumnOf<T>();
+    if (!column) {
+      return false;
+    }
+    column->MarkChanged(slot.row, changeTick);
+    return true;
+  }
+}
+
+template <SparseComponent T>
+SparseSet<T>& World::Pool()
+{
+  SparsePool*& pool = sparsePools[ComponentIdOf<T>()];
+  if (!pool) {
+    pool = new TypedSparsePool<T>();
+  }
+  return static_cast<TypedSparsePool<T>*>(pool)->set;
+}
+
+template <SparseComponent T>
+SparseSet<T>* World::FindPool()
+{
+  SparsePool** pool = sparsePools.Find(ComponentIdOf<T>());
+  return pool ? &static_cast<TypedSparsePool<T>*>(*pool)->set : nullptr;
+}
+
+template <typename... Ts>
+void CommandBuffer::Spawn(Ts... components)
+{
+  Record(std::make_tuple(std::move(components)...), [](World& world, void* payload) {
+    std::apply([&world](Ts&... stored) { world.Spawn(std::move(stored)...); },
+               *static_cast<std::tuple<Ts...>*>(payload));
+  });
+}
+
+template <typename T>
+void CommandBuffer::AddComponent(Entity entity, T component)
+{
+  Record(std::make_tuple(entity, std::move(component)), [](World& world, void* payload) {
+    auto& [target, stored] = *static_cast<std::tuple<Entity, T>*>(payload);
+    world.AddComponent(target, std::move(stored));
+  });
+}
+
+template <typename... Ts>
+void World::Touch(Archetype& archetype, Uint32 tick)
+{
+  ((std::is_const_v<Ts> ? void() : archetype.ColumnOf<Ts>()->Touch(tick)), ...);
+}
+
+template <typename... Ts, typename Fn>
+void World::RunRows(Archetype& archetype, Uint32 begin, Uint32 end, Fn& fn, Uint32 tick)
+{
+  auto    columns = std::make_tuple(archetype.Components<Ts>()...);
+  Uint32* changed[] = { (std::is_const_v<Ts> ? nullptr : archetype.ColumnOf<Ts>()->ChangedTicks())... };
+  for (Uint32* ticks : changed) {
+    if (ticks) {
+      std::fill(ticks + begin, ticks + end, tick);
+    }
+  }
+  for (Uint32 row = begin; row < end; row++) {
+    if constexpr (std::is_invocable_v<Fn&, Entity, Ts&...>) {
+      fn(archetype.EntityAt(row), std::get<Ts*>(columns)[row]...);
+    }
+    else {
+      fn(std::get<Ts*>(columns)[row]...);
+    }
+  }
+}
+
+template <typename... Ts, typename Fn>
+void World::RunFilteredRows(Archetype& archetype, Fn& fn, const Uint32* filter, Uint32 since, Uint32 tick)
+{
+  auto    columns = std::make_tuple(archetype.Components<Ts>()...);
+  Uint32* changed[] = { (std::is_const_v<Ts> ? nullptr : archetype.ColumnOf<Ts>()->ChangedTicks())... };
+  for (Uint32 row = 0; row < archetype.Count(); row++) {
+    if (filter[row] <= since) {
+      continue;
+    }
+    for (Uint32* ticks : changed) {
+      if (ticks) {
+        ticks[row] = tick;
+      }
+    }
+    if constexpr (std::is_invocable_v<Fn&, Entity, Ts&...>) {
+      fn(archetype.EntityAt(row), std::get<Ts*>(columns)[row]...);
+    }
+    else {
+      fn(std::get<Ts*>(columns)[row]...);
+    }
+  }
+}
+
+template <typename... Ts, typename Fn>
+void World::ForEach(Fn&& fn)
+{
+  const Uint32 tick = changeTick.load(std::memory_order_relaxed);
+  for (Archetype* archetype : Matching(SignatureOf<Ts...>())) {
+    Touch<Ts...>(*archetype, tick);
+    RunRows<Ts...>(*archetype, 0, archetype->Count(), fn, tick);
+  }
+}
+
+template <typename... Ts, typename Fn>
+void World::ParallelForEach(Fn&& fn, Uint32 chunkSize)
+{
+  const Uint32 tick = changeTick.load(std::memory_order_relaxed);
+  JobCounter   remaining;
+  for (Archetype* archetype : Matching(SignatureOf<Ts...>())) {
+    Touch<Ts...>(*archetype, tick);
+    // The tail of every archetype runs on the calling thread, so small archetypes never leave it.
+    const Uint32 count = archetype->Count();
+    Uint32       begin = 0;
+    for (; begin + chunkSize < count; begin += chunkSize) {
+      pool.Submit(
+          [archetype, begin, chunkSize, tick, &fn] { RunRows<Ts...>(*archetype, begin, begin + chunkSize, fn, tick); },
+          remaining);
+    }
+    RunRows<Ts...>(*archetype, begin, count, fn, tick);
+  }
+  pool.WaitFor(remaining);
+}
+
+template <typename... Ts, typename Fn>
+void World::ForEachChanged(Uint32 since, Fn&& fn)
+{
+  using Filtered = std::tuple_element_t<0, std::tuple<Ts...>>;
+  const Uint32 tick = changeTick.load(std::memory_order_relaxed);
+  for (Archetype* archetype : Matching(SignatureOf<Ts...>())) {
+    Column* filter = archetype->ColumnOf<Filtered>();
+    if (filter->LatestChange() > since) {
+      Touch<Ts...>(*archetype, tick);
+      RunFilteredRows<Ts...>(*archetype, fn, filter->ChangedTicks(), since, tick);
+    }
+  }
+}
+
+template <typename... Ts, typename Fn>
+void World::ForEachAdded(Uint32 since, Fn&& fn)
+{
+  using Filtered = std::tuple_element_t<0, std::tuple<Ts...>>;
+  const Uint32 tick = changeTick.load(std::memory_order_relaxed);
+  for (Archetype* archetype : Matching(SignatureOf<Ts...>())) {
+    Column* filter = archetype->ColumnOf<Filtered>();
+    if (filter->LatestAdd() > since) {
+      Touch<Ts...>(*archetype, tick);
+      RunFilteredRows<Ts...>(*archetype, fn, filter->AddedTicks(), since, tick);
+    }
+  }
+}
+
+template <typename... Ts, typename Fn>
+void World::ForEachChunk(Fn&& fn)
+{
+  const Uint32 tick = changeTick.load(std::memory_order_relaxed);
+  for (Archetype* archetype : Matching(SignatureOf<Ts...>())) {
+    if (archetype->Count() > 0) {
+      Touch<Ts...>(*archetype, tick);
+      Uint32* changed[] = { (std::is_const_v<Ts> ? nullptr : archetype->ColumnOf<Ts>()->ChangedTicks())... };
+      for (Uint32* ticks : changed) {
+        if (ticks) {
+          std::fill(ticks, ticks + archetype->Count(), tick);
+        }
+      }
+      fn(Span<Ts>(archetype->Components<Ts>(), archetype->Count())...);
+    }
+  }
+}
+
+template <SparseComponent T, typename Fn>
+void World::ForEachSparse(Fn&& fn)
+{
+  SparseSet<T>* pool = FindPool<T>();
+  if (!pool) {
+    return;
+  }
+  const Uint32* keys = pool->Keys();
+  T*            values = pool->Values();
+  for (Uint32 i = 0; i < pool->Count(); i++) {
+    if constexpr (std::is_invocable_v<Fn&, Entity, T&>) {
+      fn(Entity{ keys[i], slots[keys[i]].generation }, values[i]);
+    }
+    else {
+      fn(values[i]);
+    }
+  }
+}
+
 }  // namespace NycaTech
 #endif  // WORLD_H
@@ -5,7 +5,9 @@
 
 #include <iostream>
 
+#include "frame_pacer.h"
 #include "lib/assert.h"
+#include "lib/frame_arena.h"
 #include "renderer/obj_model.h"
 #include "renderer/vulkan_renderer.h"
 
@@ -16,27 +18,34 @@ int main(int argc, char* argv[])
 {
   VulkanRenderer renderer;
 
-  ObjModel* teapot = ObjModel::FromFile("../assets/teapot.obj");
+  // Prefer the cooked mesh, which maps without parsing; fall back to the OBJ when it has not been cooked.
+  ObjModel* teapot = ObjModel::FromMesh("../assets/teapot.mesh");
+  if (!teapot) {
+    teapot = ObjModel::FromFile("../assets/teapot.obj");
+  }
   Shader    vertexShader(Shader::Type::VERTEX, "../assets/vert.spv");
   Shader    fragmentShader(Shader::Type::VERTEX, "../assets/frag.spv");
 
   Assert(teapot, "unable to load assets");
   Assert(renderer.AttachShader(vertexShader) && renderer.AttachShader(fragmentShader), "unable to attach assets!");
 
-  auto running = true;
-  auto last_frame = Time::now();
+  auto       running = true;
+  auto       last_frame = MonotonicTime::now();
+  FramePacer pacer(milliseconds(12));
+  pacer.Begin();
   while (running) {
-    auto const elapsed_ms = duration_cast<milliseconds>(Time::now() - last_frame).count();
-    auto const delta = static_cast<float>(elapsed_ms) / 1000.0f;
+    auto const now = MonotonicTime::now();
+    auto const delta = duration<float>(now - last_frame).count();
     SDL_Event  event;
-    last_frame = Time::now();
+    last_frame = now;
     while (SDL_PollEvent(&event)) {
       if (event.type == SDL_QUIT || event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_ESCAPE) {
         running = !running;
       }
     }
     // Assert(renderer.DrawFrame(), "Error drawing frames");
-    sleep_until(last_frame + milliseconds(12));
+    FrameArena::NextFrame();
+    pacer.Wait();
   }
   return EXIT_SUCCESS;
 }